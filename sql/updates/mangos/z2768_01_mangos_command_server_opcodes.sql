@@ -0,0 +1,7 @@
+ALTER TABLE db_version CHANGE COLUMN required_z2767_01_mangos_power_regen required_z2768_01_mangos_command_server_opcodes bit;
+
+DELETE FROM command WHERE name IN ('server opcodes','server opcodes reset');
+
+INSERT INTO command VALUES
+('server opcodes',3,'Syntax: .server opcodes [#count]\r\n\r\nShow the #count (default 10) opcodes with the highest handler time since the last reset: handled packets, total and percentile handler time, sent packets and bytes.'),
+('server opcodes reset',3,'Syntax: .server opcodes reset\r\n\r\nReset the statistics shown by .server opcodes.');
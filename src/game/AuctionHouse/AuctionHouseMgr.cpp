@@ -33,6 +33,7 @@
 #include "WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Mails/Mail.h"
+#include "Metric/Metric.h"
 
 #include "Policies/Singleton.h"
 
@@ -440,8 +441,44 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id)
 
 void AuctionHouseMgr::Update()
 {
+    time_t curTime = sWorld.GetGameTime();
+
+    bool hasExpired = false;
     for (auto& mAuction : mAuctions)
-        mAuction.Update();
+        hasExpired = hasExpired || mAuction.HasExpiredAuctions(curTime);
+
+    if (!hasExpired)
+        return;
+
+    metric::duration<std::chrono::microseconds> meas("auctionhouse.update");
+
+    // all expiration mails and auction deletes of this update are sent to the async queue as a single transaction
+    uint32 expired = 0;
+    CharacterDatabase.BeginTransaction();
+    for (auto& mAuction : mAuctions)
+        expired += mAuction.Update();
+    CharacterDatabase.CommitTransaction();
+
+    meas.add_field("expired", std::to_string(expired));
+}
+
+std::wstring const& AuctionHouseMgr::GetItemSearchName(ItemPrototype const* proto, int locIdx)
+{
+    uint64 key = (uint64(locIdx + 1) << 32) | proto->ItemId;
+    auto itr = mItemSearchNames.find(key);
+    if (itr != mItemSearchNames.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+    sObjectMgr.GetItemLocaleStrings(proto->ItemId, locIdx, &name);
+
+    std::wstring& wname = mItemSearchNames[key];
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();                                      // never matches a search, as Utf8FitTo
+
+    return wname;
 }
 
 uint32 AuctionHouseMgr::GetAuctionHouseTeam(AuctionHouseEntry const* house)
@@ -520,33 +557,52 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
-void AuctionHouseObject::Update()
+bool AuctionHouseObject::HasExpiredAuctions(time_t curTime) const
+{
+    return !ExpiryQueue.empty() && ExpiryQueue.top().first <= curTime;
+}
+
+uint32 AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
-    ///- Handle expired auctions
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();)
+    uint32 expired = 0;
+
+    ///- Handle expired auctions, only the due part of the expiry queue is visited
+    while (HasExpiredAuctions(curTime))
     {
-        if (curTime < itr->second->expireTime)
+        uint32 auctionId = ExpiryQueue.top().second;
+        ExpiryQueue.pop();
+
+        AuctionEntryMap::iterator itr = AuctionsMap.find(auctionId);
+        if (itr == AuctionsMap.end())
+            continue;                                       // already bought out or cancelled
+
+        AuctionEntry* auction = itr->second;
+        if (curTime < auction->expireTime)
         {
-            itr++;
+            ScheduleExpire(auction);                        // stale entry of rescheduled auction
             continue;
         }
 
-        ///- perform the transaction if there was bidder.  this will alyways have the side effect of
-        ///- removing the auction from the collection.  therefore we must increment the iterator here.
-        if (itr->second->bid)
-            (itr++)->second->AuctionBidWinning();
+        ++expired;
+
+        ///- perform the transaction if there was bidder, this also removes the auction from the collection
+        if (auction->bid)
+            auction->AuctionBidWinning();
         ///- cancel the auction if there was no bidder and clear the auction
         else
         {
-            sAuctionMgr.SendAuctionExpiredMail(itr->second);
+            sAuctionMgr.SendAuctionExpiredMail(auction);
 
-            itr->second->DeleteFromDB();
-            sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
-            delete itr->second;
-            AuctionsMap.erase(itr++);
+            auction->DeleteFromDB();
+            sAuctionMgr.RemoveAItem(auction->itemGuidLow);
+            RemoveFromSearchIndexes(auction);
+            AuctionsMap.erase(itr);
+            delete auction;
         }
     }
+
+    return expired;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
@@ -592,61 +648,389 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
 {
     int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
 
-    for (auto& AentryItr : AuctionsMap)
+    auto processAuction = [&](AuctionEntry* Aentry)
     {
-        auto Aentry = AentryItr.second;
         Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
         if (!item)
-            continue;
+            return;
 
-        {
-            ItemPrototype const* proto = item->GetProto();
+        ItemPrototype const* proto = item->GetProto();
 
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
+        if (itemClass != 0xffffffff && proto->Class != itemClass)
+            return;
 
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
+        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
+            return;
 
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-                continue;
+        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+            return;
 
-            if (quality != 0xffffffff && proto->Quality < quality)
-                continue;
+        if (quality != 0xffffffff && proto->Quality < quality)
+            return;
 
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-                continue;
+        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+            return;
 
-            if (usable != 0x00)
-            {
-                if (player->CanUseItem(item) != EQUIP_ERR_OK)
-                    continue;
+        if (usable != 0x00)
+        {
+            if (player->CanUseItem(item) != EQUIP_ERR_OK)
+                return;
 
-                if (proto->Class == ITEM_CLASS_RECIPE)
+            if (proto->Class == ITEM_CLASS_RECIPE)
+            {
+                if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
                 {
-                    if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
-                    {
-                        if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
-                            continue;
-                    }
+                    if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
+                        return;
                 }
             }
+        }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
+        if (!wsearchedname.empty() && sAuctionMgr.GetItemSearchName(proto, loc_idx).find(wsearchedname) == std::wstring::npos)
+            return;
 
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
+        if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
+        {
+            ++count;
+            Aentry->BuildAuctionInfo(data);
         }
 
         ++totalcount;
+    };
+
+    // the candidates only narrow the auctions to check, every filter is still applied by processAuction
+    std::vector<uint32> candidates;
+    if (SelectSearchCandidates(candidates, wsearchedname, loc_idx, levelmin, levelmax, inventoryType, itemClass, itemSubClass, quality))
+    {
+        for (uint32 auctionId : candidates)
+        {
+            AuctionEntryMap::const_iterator itr = AuctionsMap.find(auctionId);
+            if (itr != AuctionsMap.end())
+                processAuction(itr->second);
+        }
+        return;
+    }
+
+    for (auto& AentryItr : AuctionsMap)
+        processAuction(AentryItr.second);
+}
+
+// Split a lower case search name at spaces, empty words are kept so the first and last words keep their position
+static void SplitSearchName(std::wstring const& name, std::vector<std::wstring>& words)
+{
+    size_t pos = 0;
+    for (size_t next = name.find(L' '); next != std::wstring::npos; next = name.find(L' ', pos))
+    {
+        words.push_back(name.substr(pos, next - pos));
+        pos = next + 1;
+    }
+    words.push_back(name.substr(pos));
+}
+
+static void AddNameWords(std::map<std::wstring, std::set<uint32> >& index, ItemPrototype const* proto, int locIdx)
+{
+    std::vector<std::wstring> words;
+    SplitSearchName(sAuctionMgr.GetItemSearchName(proto, locIdx), words);
+    for (std::wstring const& word : words)
+        if (!word.empty())
+            index[word].insert(proto->ItemId);
+}
+
+static void RemoveNameWords(std::map<std::wstring, std::set<uint32> >& index, ItemPrototype const* proto, int locIdx)
+{
+    std::vector<std::wstring> words;
+    SplitSearchName(sAuctionMgr.GetItemSearchName(proto, locIdx), words);
+    for (std::wstring const& word : words)
+    {
+        auto itr = index.find(word);
+        if (itr == index.end())
+            continue;
+
+        itr->second.erase(proto->ItemId);
+        if (itr->second.empty())
+            index.erase(itr);
+    }
+}
+
+AuctionHouseObject::NameWordIndex& AuctionHouseObject::GetNameWordIndex(int locIdx) const
+{
+    auto itr = NameWordIndexes.find(locIdx);
+    if (itr != NameWordIndexes.end())
+        return itr->second;
+
+    NameWordIndex& index = NameWordIndexes[locIdx];
+    for (auto const& templateItr : TemplateIndex)
+        if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(templateItr.first))
+            AddNameWords(index, proto, locIdx);
+
+    return index;
+}
+
+// Fill templates (sorted) with the listed item templates whose name can contain searchedname
+// A name containing the searched text has its inner words as whole words and a word starting with its last word,
+// a searched text without spaces can be anywhere inside a word so all distinct name words of the house are checked
+void AuctionHouseObject::SelectNameTemplates(std::vector<uint32>& templates, std::wstring const& searchedname, int locIdx) const
+{
+    NameWordIndex const& index = GetNameWordIndex(locIdx);
+
+    std::vector<std::wstring> words;
+    SplitSearchName(searchedname, words);
+
+    bool narrowed = false;
+    auto intersect = [&](std::vector<uint32>& matched)
+    {
+        std::sort(matched.begin(), matched.end());
+        matched.erase(std::unique(matched.begin(), matched.end()), matched.end());
+        if (narrowed)
+        {
+            std::vector<uint32> common;
+            std::set_intersection(templates.begin(), templates.end(), matched.begin(), matched.end(), std::back_inserter(common));
+            matched.swap(common);
+        }
+        templates.swap(matched);
+        narrowed = true;
+    };
+
+    std::vector<uint32> matched;
+    if (words.size() == 1)
+    {
+        for (auto const& wordItr : index)
+            if (wordItr.first.find(words[0]) != std::wstring::npos)
+                matched.insert(matched.end(), wordItr.second.begin(), wordItr.second.end());
+        intersect(matched);
+        return;
+    }
+
+    for (size_t i = 1; i + 1 < words.size(); ++i)
+    {
+        if (words[i].empty())
+            continue;
+
+        matched.clear();
+        auto itr = index.find(words[i]);
+        if (itr != index.end())
+            matched.assign(itr->second.begin(), itr->second.end());
+        intersect(matched);
+        if (templates.empty())
+            return;
+    }
+
+    std::wstring const& last = words.back();
+    if (!last.empty())
+    {
+        matched.clear();
+        for (auto itr = index.lower_bound(last); itr != index.end() && itr->first.compare(0, last.size(), last) == 0; ++itr)
+            matched.insert(matched.end(), itr->second.begin(), itr->second.end());
+        intersect(matched);
     }
+
+    // only the first word (a word ending) or spaces were searched: every listed template can match
+    if (!narrowed)
+        for (auto const& templateItr : TemplateIndex)
+            templates.push_back(templateItr.first);
+}
+
+// Fill candidates with the ids (in AuctionsMap order) of the auctions found in all indexes that apply to the search
+// Returns false if no index can narrow the search (all auctions have to be checked)
+bool AuctionHouseObject::SelectSearchCandidates(std::vector<uint32>& candidates, std::wstring const& searchedname, int locIdx,
+        uint32 levelmin, uint32 levelmax, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality) const
+{
+    typedef std::vector<AuctionIdSet const*> AuctionIdSets; // union of these sets matches one filter
+    std::vector<std::pair<size_t, AuctionIdSets> > filters;
+
+    auto addFilter = [&](AuctionIdSets const& sets)
+    {
+        size_t size = 0;
+        for (AuctionIdSet const* set : sets)
+            size += set->size();
+        filters.push_back(std::make_pair(size, sets));
+    };
+
+    auto lookup = [](AuctionIndex const& index, uint32 key, AuctionIdSets& sets)
+    {
+        AuctionIndex::const_iterator itr = index.find(key);
+        if (itr != index.end())
+            sets.push_back(&itr->second);
+    };
+
+    AuctionIdSets sets;
+    if (itemClass != 0xffffffff)
+    {
+        sets.clear();
+        if (itemSubClass != 0xffffffff)
+            lookup(SubClassIndex, (itemClass << 16) | itemSubClass, sets);
+        else
+            lookup(ClassIndex, itemClass, sets);
+        addFilter(sets);
+    }
+
+    if (inventoryType != 0xffffffff)
+    {
+        sets.clear();
+        lookup(InventoryTypeIndex, inventoryType, sets);
+        addFilter(sets);
+    }
+
+    if (quality != 0xffffffff && quality > ITEM_QUALITY_POOR)
+    {
+        sets.clear();
+        for (uint32 i = quality; i < MAX_ITEM_QUALITY; ++i)
+            lookup(QualityIndex, i, sets);
+        addFilter(sets);
+    }
+
+    if (levelmin != 0x00)
+    {
+        sets.clear();
+        for (auto const& levelItr : RequiredLevelIndex)
+            if (levelItr.first >= levelmin && (levelmax == 0x00 || levelItr.first <= levelmax))
+                sets.push_back(&levelItr.second);
+        addFilter(sets);
+    }
+
+    if (!searchedname.empty())
+    {
+        std::vector<uint32> templates;
+        SelectNameTemplates(templates, searchedname, locIdx);
+
+        sets.clear();
+        for (uint32 templateId : templates)
+            lookup(TemplateIndex, templateId, sets);
+        addFilter(sets);
+    }
+
+    if (filters.empty())
+        return false;
+
+    // start from the most selective filter, the others only drop candidates
+    std::sort(filters.begin(), filters.end(), [](std::pair<size_t, AuctionIdSets> const& a, std::pair<size_t, AuctionIdSets> const& b)
+    {
+        return a.first < b.first;
+    });
+
+    if (filters.size() == 1 && filters[0].first >= AuctionsMap.size())
+        return false;
+
+    AuctionIdSets const& first = filters[0].second;
+    candidates.reserve(filters[0].first);
+    for (AuctionIdSet const* set : first)
+        candidates.insert(candidates.end(), set->begin(), set->end());
+
+    if (first.size() > 1)
+        std::sort(candidates.begin(), candidates.end());
+
+    for (size_t i = 1; i < filters.size() && !candidates.empty(); ++i)
+    {
+        AuctionIdSets const& filterSets = filters[i].second;
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&filterSets](uint32 auctionId)
+        {
+            for (AuctionIdSet const* set : filterSets)
+                if (set->find(auctionId) != set->end())
+                    return false;
+            return true;
+        }), candidates.end());
+    }
+
+    return true;
+}
+
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
+{
+    MANGOS_ASSERT(ah);
+
+    AuctionEntryMap::iterator itr = AuctionsMap.find(ah->Id);
+    if (itr != AuctionsMap.end())
+    {
+        RemoveFromSearchIndexes(itr->second);
+        itr->second = ah;
+    }
+    else
+        AuctionsMap[ah->Id] = ah;
+
+    AddToSearchIndexes(ah);
+    ScheduleExpire(ah);
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    RemoveFromSearchIndexes(itr->second);
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::SetExpireTime(AuctionEntry* auction, time_t expireTime)
+{
+    auction->expireTime = expireTime;
+    ScheduleExpire(auction);
+}
+
+void AuctionHouseObject::ScheduleExpire(AuctionEntry const* auction)
+{
+    // rebuild when stale entries of sold or cancelled auctions outnumber the listed ones
+    if (ExpiryQueue.size() > 2 * AuctionsMap.size() + 1024)
+    {
+        std::vector<AuctionExpiry> entries;
+        entries.reserve(AuctionsMap.size());
+        for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+            if (itr->second != auction)
+                entries.push_back(AuctionExpiry(itr->second->expireTime, itr->first));
+
+        ExpiryQueue = AuctionExpiryQueue(std::greater<AuctionExpiry>(), std::move(entries));
+    }
+
+    ExpiryQueue.push(AuctionExpiry(auction->expireTime, auction->Id));
+}
+
+void AuctionHouseObject::AddToSearchIndexes(AuctionEntry const* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    ClassIndex[proto->Class].insert(auction->Id);
+    SubClassIndex[(proto->Class << 16) | proto->SubClass].insert(auction->Id);
+    InventoryTypeIndex[proto->InventoryType].insert(auction->Id);
+    QualityIndex[proto->Quality].insert(auction->Id);
+    RequiredLevelIndex[proto->RequiredLevel].insert(auction->Id);
+
+    AuctionIdSet& templateAuctions = TemplateIndex[proto->ItemId];
+    if (templateAuctions.empty())                           // first listing of the template
+        for (auto& nameIndexItr : NameWordIndexes)
+            AddNameWords(nameIndexItr.second, proto, nameIndexItr.first);
+    templateAuctions.insert(auction->Id);
+}
+
+void AuctionHouseObject::RemoveFromSearchIndexes(AuctionEntry const* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    auto remove = [&auction](AuctionIndex& index, uint32 key)
+    {
+        AuctionIndex::iterator itr = index.find(key);
+        if (itr == index.end())
+            return;
+
+        itr->second.erase(auction->Id);
+        if (itr->second.empty())
+            index.erase(itr);
+    };
+
+    remove(ClassIndex, proto->Class);
+    remove(SubClassIndex, (proto->Class << 16) | proto->SubClass);
+    remove(InventoryTypeIndex, proto->InventoryType);
+    remove(QualityIndex, proto->Quality);
+    remove(RequiredLevelIndex, proto->RequiredLevel);
+    remove(TemplateIndex, proto->ItemId);
+
+    if (TemplateIndex.find(proto->ItemId) == TemplateIndex.end()) // last listing of the template is gone
+        for (auto& nameIndexItr : NameWordIndexes)
+            RemoveNameWords(nameIndexItr.second, proto, nameIndexItr.first);
 }
 
 AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout, uint32 deposit, Player* pl /*= nullptr*/)
@@ -761,11 +1145,15 @@ void AuctionEntry::AuctionBidWinning(Player* newbidder)
     sAuctionMgr.RemoveAItem(this->itemGuidLow);
     sAuctionMgr.GetAuctionsMap(this->auctionHouseEntry)->RemoveAuction(this->Id);
 
-    CharacterDatabase.BeginTransaction();
+    // expired auctions are finished inside the batched AuctionHouseMgr::Update transaction
+    bool const ownTransaction = !CharacterDatabase.IsInTransaction();
+    if (ownTransaction)
+        CharacterDatabase.BeginTransaction();
     this->DeleteFromDB();
     if (newbidder)
         newbidder->SaveInventoryAndGoldToDB();
-    CharacterDatabase.CommitTransaction();
+    if (ownTransaction)
+        CharacterDatabase.CommitTransaction();
 
     delete this;
 }
@@ -24,6 +24,7 @@
 
 class Item;
 class Player;
+struct ItemPrototype;
 class Unit;
 class WorldPacket;
 
@@ -98,11 +99,7 @@ class AuctionHouseObject
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -110,9 +107,13 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : nullptr;
         }
 
-        bool RemoveAuction(uint32 id) { return !!AuctionsMap.erase(id); }
+        bool RemoveAuction(uint32 id);
 
-        void Update();
+        // reschedule auction expiration, expireTime must not be changed directly for listed auctions
+        void SetExpireTime(AuctionEntry* auction, time_t expireTime);
+
+        bool HasExpiredAuctions(time_t curTime) const;
+        uint32 Update();                                    // returns count of expired auctions
 
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
@@ -121,8 +122,39 @@ class AuctionHouseObject
                                    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
                                    uint32& count, uint32& totalcount);
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
+
+        // drop the name word indexes, they are rebuilt at the next name search (localized names changed)
+        void ClearNameWordIndexes() { NameWordIndexes.clear(); }
     private:
+        typedef std::set<uint32> AuctionIdSet;              // auction ids, same order as AuctionsMap
+        typedef std::unordered_map<uint32, AuctionIdSet> AuctionIndex;
+        typedef std::map<std::wstring, std::set<uint32> > NameWordIndex; // search name word -> item template entries
+        typedef std::pair<time_t, uint32> AuctionExpiry;    // expire time, auction id
+        typedef std::priority_queue<AuctionExpiry, std::vector<AuctionExpiry>, std::greater<AuctionExpiry> > AuctionExpiryQueue;
+
+        void AddToSearchIndexes(AuctionEntry const* auction);
+        void RemoveFromSearchIndexes(AuctionEntry const* auction);
+        bool SelectSearchCandidates(std::vector<uint32>& candidates, std::wstring const& searchedname, int locIdx,
+                                    uint32 levelmin, uint32 levelmax, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality) const;
+        void SelectNameTemplates(std::vector<uint32>& templates, std::wstring const& searchedname, int locIdx) const;
+        NameWordIndex& GetNameWordIndex(int locIdx) const;
+        void ScheduleExpire(AuctionEntry const* auction);
+
         AuctionEntryMap AuctionsMap;
+
+        // min-heap of auction expire times, entries of removed or rescheduled auctions are dropped lazily at pop
+        AuctionExpiryQueue ExpiryQueue;
+
+        // search indexes, maintained at auction add/remove and used by BuildListAuctionItems
+        AuctionIndex ClassIndex;                            // item class
+        AuctionIndex SubClassIndex;                         // item class << 16 | item subclass
+        AuctionIndex InventoryTypeIndex;                    // item inventory type
+        AuctionIndex QualityIndex;                          // item quality
+        AuctionIndex RequiredLevelIndex;                    // item required level
+        AuctionIndex TemplateIndex;                         // item template entry (name searches)
+
+        // per locale words of the listed item template names, built at the first name search in the locale
+        mutable std::unordered_map<int, NameWordIndex> NameWordIndexes;
 };
 
 enum AuctionHouseType
@@ -162,6 +194,15 @@ class AuctionHouseMgr
         static uint32 GetAuctionDeposit(AuctionHouseEntry const* entry, uint32 time, Item* pItem);
 
         static uint32 GetAuctionHouseTeam(AuctionHouseEntry const* house);
+
+        // lower case localized item name used by auction searches, cached per locale
+        std::wstring const& GetItemSearchName(ItemPrototype const* proto, int locIdx);
+        void ClearItemSearchNames()
+        {
+            mItemSearchNames.clear();
+            for (auto& mAuction : mAuctions)
+                mAuction.ClearNameWordIndexes();
+        }
         static AuctionHouseEntry const* GetAuctionHouseEntry(Unit* unit);
 
     public:
@@ -178,6 +219,8 @@ class AuctionHouseMgr
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        std::unordered_map<uint64, std::wstring> mItemSearchNames; // key: (locale index + 1) << 32 | item entry
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
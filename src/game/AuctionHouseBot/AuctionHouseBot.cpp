@@ -26,11 +26,12 @@
 
 // Format is YYYYMMDDRR where RR is the change in the conf file
 // for that day.
-#define AUCTIONHOUSEBOT_CONF_VERSION    2020010101
+#define AUCTIONHOUSEBOT_CONF_VERSION    2026101701
 
 INSTANTIATE_SINGLETON_1(AuctionHouseBot);
 
-AuctionHouseBot::AuctionHouseBot() : m_configFileName(_AUCTIONHOUSEBOT_CONFIG), m_houseAction(-1)
+AuctionHouseBot::AuctionHouseBot() : m_configFileName(_AUCTIONHOUSEBOT_CONFIG), m_houseAction(-1), m_chanceSell(0), m_chanceBuy(0),
+    m_budgetPerTick(10), m_sellRequest(-1), m_spreadTimer(0)
 {
 }
 
@@ -49,6 +50,7 @@ void AuctionHouseBot::Initialize()
 
     m_chanceSell = GetMinMaxConfig("AuctionHouseBot.Chance.Sell", 0, 100, 10);
     m_chanceBuy = GetMinMaxConfig("AuctionHouseBot.Chance.Buy", 0, 100, 10);
+    m_budgetPerTick = GetMinMaxConfig("AuctionHouseBot.Budget.PerTick", 1, 1000, 10);
 
     sLog.outString("AHBot selling items: %s", m_chanceSell > 0 ? "Enabled" : "Disabled");
     sLog.outString("AHBot buying items: %s", m_chanceBuy > 0 ? "Enabled" : "Disabled");
@@ -151,118 +153,193 @@ void AuctionHouseBot::Initialize()
 
 void AuctionHouseBot::Update()
 {
+    // orders left from the previous visit get the whole next interval
+    m_spreadTimer = AUCTIONHOUSEBOT_UPDATE_INTERVAL;
+
     if (++m_houseAction >= MAX_AUCTION_HOUSE_TYPE * 2)
         m_houseAction = 0;
 
     AuctionHouseType houseType = AuctionHouseType(m_houseAction % MAX_AUCTION_HOUSE_TYPE);
-    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(houseType);
     if (m_houseAction < MAX_AUCTION_HOUSE_TYPE && urand(0, 99) < m_chanceSell)
     {
-        // Sell items
-        std::unordered_map<uint32, uint32> itemMap;
-
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootNormalConfig, m_creatureLootNormalTemplates, itemMap);       // normal creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootEliteConfig, m_creatureLootEliteTemplates, itemMap);         // elite creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootRareEliteConfig, m_creatureLootRareEliteTemplates, itemMap); // rare elite creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootWorldBossConfig, m_creatureLootWorldBossTemplates, itemMap); // world boss creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootRareConfig, m_creatureLootRareTemplates, itemMap);           // rare creature loot
-
-        AddLootToItemMap(&LootTemplates_Disenchant, m_disenchantLootConfig, m_disenchantLootTemplates, itemMap);             // disenchant loot
-        AddLootToItemMap(&LootTemplates_Fishing, m_fishingLootConfig, m_fishingLootTemplates, itemMap);                      // fishing loot
-        AddLootToItemMap(&LootTemplates_Gameobject, m_gameobjectLootConfig, m_gameobjectLootTemplates, itemMap);             // gameobject loot
-        AddLootToItemMap(&LootTemplates_Skinning, m_skinningLootConfig, m_skinningLootTemplates, itemMap);                   // skinning loot
-
-        // profession items are a bit different (not looted)
-        if (m_professionItemsConfig[1] > 0 && m_professionItemsConfig[3] > 0 && m_professionItems.size() > 0)
+        // Sell items, the orders are prepared by StartPreparation/FinishPreparation
+        if (m_pendingSells.empty() && !m_sellPreparation.valid())
+            m_sellRequest = houseType;
+    }
+    else if (m_houseAction >= MAX_AUCTION_HOUSE_TYPE && urand(0, 99) < m_chanceBuy)
+        PrepareBuyOrders(houseType);
+}
+
+void AuctionHouseBot::UpdatePendingOrders(uint32 diff)
+{
+    uint32 pending = m_pendingSells.size() + m_pendingBuys.size();
+    if (!pending)
+        return;
+
+    // spread the pending orders evenly over the time left until the next visit
+    uint32 timeLeft = std::max(m_spreadTimer, diff);
+    uint32 orders = uint32((uint64(pending) * diff + timeLeft - 1) / timeLeft);
+    m_spreadTimer = m_spreadTimer > diff ? m_spreadTimer - diff : 0;
+
+    ProcessPendingOrders(std::min(orders, m_budgetPerTick));
+}
+
+void AuctionHouseBot::StartPreparation()
+{
+    if (m_sellRequest < 0)
+        return;
+
+    AuctionHouseType houseType = AuctionHouseType(m_sellRequest);
+    m_sellRequest = -1;
+
+    // loot templates, item prototypes and bot config are only changed by the world thread outside of the map updates
+    m_sellPreparation = std::async(std::launch::async, [this, houseType]()
+    {
+        AuctionHouseBotSellOrders orders;
+        PrepareSellOrders(houseType, orders);
+        return orders;
+    });
+}
+
+void AuctionHouseBot::FinishPreparation()
+{
+    if (!m_sellPreparation.valid())
+        return;
+
+    AuctionHouseBotSellOrders orders = m_sellPreparation.get();
+    m_pendingSells.insert(m_pendingSells.end(), orders.begin(), orders.end());
+}
+
+void AuctionHouseBot::PrepareSellOrders(AuctionHouseType houseType, AuctionHouseBotSellOrders& orders)
+{
+    std::unordered_map<uint32, uint32> itemMap;
+
+    AddLootToItemMap(&LootTemplates_Creature, m_creatureLootNormalConfig, m_creatureLootNormalTemplates, itemMap);       // normal creature loot
+    AddLootToItemMap(&LootTemplates_Creature, m_creatureLootEliteConfig, m_creatureLootEliteTemplates, itemMap);         // elite creature loot
+    AddLootToItemMap(&LootTemplates_Creature, m_creatureLootRareEliteConfig, m_creatureLootRareEliteTemplates, itemMap); // rare elite creature loot
+    AddLootToItemMap(&LootTemplates_Creature, m_creatureLootWorldBossConfig, m_creatureLootWorldBossTemplates, itemMap); // world boss creature loot
+    AddLootToItemMap(&LootTemplates_Creature, m_creatureLootRareConfig, m_creatureLootRareTemplates, itemMap);           // rare creature loot
+
+    AddLootToItemMap(&LootTemplates_Disenchant, m_disenchantLootConfig, m_disenchantLootTemplates, itemMap);             // disenchant loot
+    AddLootToItemMap(&LootTemplates_Fishing, m_fishingLootConfig, m_fishingLootTemplates, itemMap);                      // fishing loot
+    AddLootToItemMap(&LootTemplates_Gameobject, m_gameobjectLootConfig, m_gameobjectLootTemplates, itemMap);             // gameobject loot
+    AddLootToItemMap(&LootTemplates_Skinning, m_skinningLootConfig, m_skinningLootTemplates, itemMap);                   // skinning loot
+
+    // profession items are a bit different (not looted)
+    if (m_professionItemsConfig[1] > 0 && m_professionItemsConfig[3] > 0 && m_professionItems.size() > 0)
+    {
+        int32 maxTemplates = m_professionItemsConfig[0] < 0 ? urand(0, m_professionItemsConfig[1] - m_professionItemsConfig[0]) + m_professionItemsConfig[0] : urand(m_professionItemsConfig[0], m_professionItemsConfig[1]);
+        if (maxTemplates > 0)
         {
-            int32 maxTemplates = m_professionItemsConfig[0] < 0 ? urand(0, m_professionItemsConfig[1] - m_professionItemsConfig[0]) + m_professionItemsConfig[0] : urand(m_professionItemsConfig[0], m_professionItemsConfig[1]);
-            if (maxTemplates > 0)
+            for (uint32 templateCounter = 0; templateCounter < maxTemplates; ++templateCounter)
             {
-                for (uint32 templateCounter = 0; templateCounter < maxTemplates; ++templateCounter)
-                {
-                    uint32 item = m_professionItems[urand(0, m_professionItems.size() - 1)];
-                    ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(item);
-                    if (!prototype || prototype->Quality == 0 || urand(0, (1 << (prototype->Quality - 1)) - 1) > 0)
-                        continue; // make it decreasingly likely that crafted items of higher quality is added to the auction house (white: 100%, green: 50%, blue: 25%, purple: 12.5%, ...)
-                    uint32 count = (uint32) round(prototype->GetMaxStackSize() * urand(m_professionItemsConfig[2], m_professionItemsConfig[3]) / 100.0);
-                    itemMap[item] += count;
-                }
+                uint32 item = m_professionItems[urand(0, m_professionItems.size() - 1)];
+                ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(item);
+                if (!prototype || prototype->Quality == 0 || urand(0, (1 << (prototype->Quality - 1)) - 1) > 0)
+                    continue; // make it decreasingly likely that crafted items of higher quality is added to the auction house (white: 100%, green: 50%, blue: 25%, purple: 12.5%, ...)
+                uint32 count = (uint32) round(prototype->GetMaxStackSize() * urand(m_professionItemsConfig[2], m_professionItemsConfig[3]) / 100.0);
+                itemMap[item] += count;
             }
         }
+    }
+
+    // remove items we've overridden (AddChance > 0) and add using given AddChance and stack size
+    for (auto itemData : m_itemData)
+    {
+        if (itemData.second.AddChance > 0) // replace normal loot sources with custom chance of adding item
+            itemMap[itemData.first] = urand(0, 99) < itemData.second.AddChance ? urand(itemData.second.MinAmount, itemData.second.MaxAmount) : 0;
+    }
 
-        // remove items we've overridden (AddChance > 0) and add using given AddChance and stack size
-        for (auto itemData : m_itemData)
+    for (auto itemEntry : itemMap)
+    {
+        ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(itemEntry.first);
+        if (!prototype || prototype->GetMaxStackSize() == 0)
+            continue; // really shouldn't happen, but better safe than sorry
+        auto iterator = m_itemData.find(prototype->ItemId);
+        if (iterator != m_itemData.end() && iterator->second.Value == 0)
+            continue; // item is blacklisted
+        if (iterator == m_itemData.end() || iterator->second.AddChance == 0)
         {
-            if (itemData.second.AddChance > 0) // replace normal loot sources with custom chance of adding item
-                itemMap[itemData.first] = urand(0, 99) < itemData.second.AddChance ? urand(itemData.second.MinAmount, itemData.second.MaxAmount) : 0;
+            if (prototype->Bonding == BIND_WHEN_PICKED_UP || prototype->Bonding == BIND_QUEST_ITEM)
+                continue; // nor BoP and quest items
+            if (prototype->Flags & ITEM_FLAG_HAS_LOOT)
+                continue; // no items containing loot
+            if (m_itemValue[prototype->Quality][prototype->Class] == 0)
+                continue; // item class is filtered out
         }
 
-        for (auto itemEntry : itemMap)
+        uint32 itemValue = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
+        for (uint32 stackCounter = 0; stackCounter < itemEntry.second; stackCounter += prototype->GetMaxStackSize())
         {
-            ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(itemEntry.first);
-            if (!prototype || prototype->GetMaxStackSize() == 0)
-                continue; // really shouldn't happen, but better safe than sorry
-            auto iterator = m_itemData.find(prototype->ItemId);
-            if (iterator != m_itemData.end() && iterator->second.Value == 0)
-                continue; // item is blacklisted
-            if (iterator == m_itemData.end() || iterator->second.AddChance == 0)
-            {
-                if (prototype->Bonding == BIND_WHEN_PICKED_UP || prototype->Bonding == BIND_QUEST_ITEM)
-                    continue; // nor BoP and quest items
-                if (prototype->Flags & ITEM_FLAG_HAS_LOOT)
-                    continue; // no items containing loot
-                if (m_itemValue[prototype->Quality][prototype->Class] == 0)
-                    continue; // item class is filtered out
-            }
-
-            uint32 itemValue = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
-            for (uint32 stackCounter = 0; stackCounter < itemEntry.second; stackCounter += prototype->GetMaxStackSize())
-            {
-                uint32 count = itemEntry.second - stackCounter > prototype->GetMaxStackSize() ? prototype->GetMaxStackSize() : itemEntry.second - stackCounter;
-                uint32 buyoutPrice = itemValue * count;
-                Item* item = Item::CreateItem(itemEntry.first, count);
-                if (buyoutPrice == 0 || !item)
-                    continue; // don't put up items we don't know the value of
-                uint32 bidPrice = buyoutPrice * (urand(m_auctionBidMin, m_auctionBidMax)) / 100;
-                if (item)
-                    auctionHouse->AddAuction(sAuctionHouseStore.LookupEntry(houseType == AUCTION_HOUSE_ALLIANCE ? 1 : (houseType == AUCTION_HOUSE_HORDE ? 6 : 7)), item, urand(m_auctionTimeMin, m_auctionTimeMax) * HOUR, bidPrice, buyoutPrice);
-            }
+            uint32 count = itemEntry.second - stackCounter > prototype->GetMaxStackSize() ? prototype->GetMaxStackSize() : itemEntry.second - stackCounter;
+            uint32 buyoutPrice = itemValue * count;
+            if (buyoutPrice == 0)
+                continue; // don't put up items we don't know the value of
+            uint32 bidPrice = buyoutPrice * (urand(m_auctionBidMin, m_auctionBidMax)) / 100;
+            orders.push_back({ houseType, itemEntry.first, count, bidPrice, buyoutPrice, urand(m_auctionTimeMin, m_auctionTimeMax) * HOUR });
         }
-    } else if (m_houseAction >= MAX_AUCTION_HOUSE_TYPE && urand(0, 99) < m_chanceBuy)
+    }
+}
+
+void AuctionHouseBot::PrepareBuyOrders(AuctionHouseType houseType)
+{
+    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(houseType);
+    AuctionHouseObject::AuctionEntryMapBounds bounds = auctionHouse->GetAuctionsBounds();
+    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
     {
-        // Buy items
-        AuctionHouseObject::AuctionEntryMapBounds bounds = auctionHouse->GetAuctionsBounds();
-        std::vector<AuctionEntry*> buyoutAuctions;
-        for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-        {
-            AuctionEntry* auction = itr->second;
-            if (auction->owner == 0 && auction->bid == 0)
-                continue; // ignore bidding/buying auctions that were created by ahbot and not bidded on by player
-            Item* item = sAuctionMgr.GetAItem(auction->itemGuidLow);
-            auto prototype = item->GetProto();
-            if (!prototype)
-                continue; // shouldn't happen
-            auto iterator = m_itemData.find(prototype->ItemId);
-            if (iterator != m_itemData.end() && iterator->second.Value == 0)
-                continue; // item is blacklisted
-
-            uint32 buyItemCheck = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
-            buyItemCheck *= item->GetCount();
-            uint32 bidPrice = auction->bid + auction->GetAuctionOutBid();
-            if (auction->startbid > bidPrice)
-                bidPrice = auction->startbid;
-            if (auction->buyout > 0 && buyItemCheck > auction->buyout)
-                buyoutAuctions.push_back(auction); // can't buyout item here as that modifies the AuctionEntryMap, invalidating the iterator
-            else if (buyItemCheck > bidPrice)
-                auction->UpdateBid(bidPrice);
-        }
-        for (auto auction : buyoutAuctions)
-            auction->UpdateBid(auction->buyout);
+        AuctionEntry* auction = itr->second;
+        if (auction->owner == 0 && auction->bid == 0)
+            continue; // ignore bidding/buying auctions that were created by ahbot and not bidded on by player
+        Item* item = sAuctionMgr.GetAItem(auction->itemGuidLow);
+        auto prototype = item->GetProto();
+        if (!prototype)
+            continue; // shouldn't happen
+        auto iterator = m_itemData.find(prototype->ItemId);
+        if (iterator != m_itemData.end() && iterator->second.Value == 0)
+            continue; // item is blacklisted
+
+        uint32 buyItemCheck = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
+        buyItemCheck *= item->GetCount();
+        uint32 bidPrice = auction->bid + auction->GetAuctionOutBid();
+        if (auction->startbid > bidPrice)
+            bidPrice = auction->startbid;
+        if (auction->buyout > 0 && buyItemCheck > auction->buyout)
+            m_pendingBuys.push_back({ houseType, auction->Id, auction->bid, auction->buyout });
+        else if (buyItemCheck > bidPrice)
+            m_pendingBuys.push_back({ houseType, auction->Id, auction->bid, bidPrice });
+    }
+}
+
+void AuctionHouseBot::ProcessPendingOrders(uint32 maxOrders)
+{
+    for (; maxOrders > 0 && !m_pendingBuys.empty(); --maxOrders)
+    {
+        AuctionHouseBotBuyOrder order = m_pendingBuys.front();
+        m_pendingBuys.pop_front();
+
+        AuctionEntry* auction = sAuctionMgr.GetAuctionsMap(order.HouseType)->GetAuction(order.AuctionId);
+        if (!auction || auction->bid != order.ExpectedBid)
+            continue; // sold, expired or outbid since the visit
+
+        auction->UpdateBid(order.Price);
+    }
+
+    for (; maxOrders > 0 && !m_pendingSells.empty(); --maxOrders)
+    {
+        AuctionHouseBotSellOrder order = m_pendingSells.front();
+        m_pendingSells.pop_front();
+
+        Item* item = Item::CreateItem(order.ItemId, order.Count);
+        if (!item)
+            continue;
+
+        sAuctionMgr.GetAuctionsMap(order.HouseType)->AddAuction(sAuctionHouseStore.LookupEntry(order.HouseType == AUCTION_HOUSE_ALLIANCE ? 1 : (order.HouseType == AUCTION_HOUSE_HORDE ? 6 : 7)), item, order.AuctionTime, order.BidPrice, order.BuyoutPrice);
     }
 }
 
 bool AuctionHouseBot::ReloadAllConfig()
 {
+    FinishPreparation();
     Initialize();
     return true;
 }
@@ -280,7 +357,7 @@ void AuctionHouseBot::Rebuild(bool all)
             {
                 // ahbot auction
                 if (all || entry->bid == 0) // expire auction if no bid or forced
-                    entry->expireTime = sWorld.GetGameTime();
+                    sAuctionMgr.GetAuctionsMap(AuctionHouseType(i))->SetExpireTime(entry, sWorld.GetGameTime());
             }
         }
     }
@@ -291,6 +368,16 @@ void AuctionHouseBot::Rebuild(bool all)
         if (m_houseAction >= MAX_AUCTION_HOUSE_TYPE - 1)
             m_houseAction = -1; // this prevents AHBot from buying items when refilling
         Update();
+
+        // refill is done at once, no need to spread it
+        if (m_sellRequest >= 0)
+        {
+            AuctionHouseBotSellOrders orders;
+            PrepareSellOrders(AuctionHouseType(m_sellRequest), orders);
+            m_pendingSells.insert(m_pendingSells.end(), orders.begin(), orders.end());
+            m_sellRequest = -1;
+        }
+        ProcessPendingOrders(m_pendingSells.size() + m_pendingBuys.size());
     }
 }
 
@@ -26,6 +26,11 @@
 #include "Loot/LootMgr.h"
 #include "Util.h"
 
+#include <deque>
+#include <future>
+
+#define AUCTIONHOUSEBOT_UPDATE_INTERVAL (20 * IN_MILLISECONDS)  // time between bot visits at the auction houses
+
 struct AuctionHouseBotItemData
 {
     uint32 Value = 0;
@@ -42,6 +47,28 @@ struct AuctionHouseBotStatusInfoPerType
 
 typedef AuctionHouseBotStatusInfoPerType AuctionHouseBotStatusInfo[MAX_AUCTION_HOUSE_TYPE];
 
+// auction prepared at a bot visit, posted later within the per update budget
+struct AuctionHouseBotSellOrder
+{
+    AuctionHouseType HouseType;
+    uint32 ItemId;
+    uint32 Count;
+    uint32 BidPrice;
+    uint32 BuyoutPrice;
+    uint32 AuctionTime;
+};
+
+// bid or buyout decided at a bot visit, dropped if the auction changed in the meantime
+struct AuctionHouseBotBuyOrder
+{
+    AuctionHouseType HouseType;
+    uint32 AuctionId;
+    uint32 ExpectedBid;                                     // auction bid at decision time
+    uint32 Price;
+};
+
+typedef std::vector<AuctionHouseBotSellOrder> AuctionHouseBotSellOrders;
+
 class AuctionHouseBot
 {
     public:
@@ -50,7 +77,12 @@ class AuctionHouseBot
 
         void Initialize();
         void SetConfigFileName(const std::string& filename) { m_configFileName = filename; }
-        void Update();
+        void Update();                                      // bot visit, every AUCTIONHOUSEBOT_UPDATE_INTERVAL
+        void UpdatePendingOrders(uint32 diff);              // every world update, posts/buys within the budget
+
+        // sell orders are prepared in a worker thread while the world thread waits for the map updates
+        void StartPreparation();
+        void FinishPreparation();
 
         // Following methods are mainly used by level3.cpp for ingame/console commands
         bool ReloadAllConfig();
@@ -66,6 +98,9 @@ class AuctionHouseBot
         void ParseItemValueConfig(char const* fieldname, std::vector<uint32>& itemValues);
         void AddLootToItemMap(LootStore* store, std::vector<int32>& lootConfig, std::vector<uint32>& lootTemplates, std::unordered_map<uint32, uint32>& itemMap);
         uint32 CalculateBuyoutPrice(ItemPrototype const* prototype);
+        void PrepareSellOrders(AuctionHouseType houseType, AuctionHouseBotSellOrders& orders);
+        void PrepareBuyOrders(AuctionHouseType houseType);
+        void ProcessPendingOrders(uint32 maxOrders);
         uint32 ValueWithVariance(uint32 itemValue) { return (uint32) (itemValue + ((int32) urand(0, m_valueVariance * 2 + 1) - (int32) m_valueVariance) * (int32) (itemValue / 100)); };
 
         std::string m_configFileName;
@@ -75,6 +110,13 @@ class AuctionHouseBot
 
         uint32 m_chanceSell;
         uint32 m_chanceBuy;
+        uint32 m_budgetPerTick;
+
+        int32 m_sellRequest;                                // house type to prepare sell orders for, -1 if none
+        std::future<AuctionHouseBotSellOrders> m_sellPreparation;
+        std::deque<AuctionHouseBotSellOrder> m_pendingSells;
+        std::deque<AuctionHouseBotBuyOrder> m_pendingBuys;
+        uint32 m_spreadTimer;                               // time left to post the pending orders in
 
         std::vector<int32> m_creatureLootNormalConfig;
         std::vector<int32> m_creatureLootRareConfig;
@@ -54,6 +54,10 @@ BattleGroundQueue::BattleGroundQueue()
                 m_waitTimes[i][j][k] = 0;
         }
     }
+
+    for (auto& waitingPlayers : m_waitingPlayers)
+        for (uint32& count : waitingPlayers)
+            count = 0;
 }
 
 BattleGroundQueue::~BattleGroundQueue()
@@ -159,6 +163,7 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
     queueInfo->joinTime                  = WorldTimer::getMSTime();
     queueInfo->removeInviteTime          = 0;
     queueInfo->groupTeam                 = leader->GetTeam();
+    queueInfo->bracketId                 = bracketId;
 
     queueInfo->players.clear();
 
@@ -170,6 +175,8 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
     if (queueInfo->groupTeam == HORDE)
         ++index;                                            // BG_QUEUE_*_ALLIANCE -> BG_QUEUE_*_HORDE
 
+    queueInfo->queueIndex = index;
+
     DEBUG_LOG("Adding Group to BattleGroundQueue bgTypeId : %u, bracket_id : %u, index : %u", bgTypeId, bracketId, index);
 
     uint32 lastOnlineTime = WorldTimer::getMSTime();
@@ -201,6 +208,7 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
 
         // add GroupInfo to m_QueuedGroups
         m_queuedGroups[bracketId][index].push_back(queueInfo);
+        m_waitingPlayers[bracketId][index] += queueInfo->players.size();
 
         // announce to world, this code needs mutex
         if (!isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -209,17 +217,9 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
             {
                 char const* bgName = bg->GetName();
                 uint32 minPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE];
+                uint32 qAlliance = m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE];
                 uint32 q_min_level = leader->GetMinLevelForBattleGroundBracketId(bracketId, bgTypeId);
-                GroupsQueueType::const_iterator itr;
-                for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->isInvitedToBgInstanceGuid)
-                        qAlliance += (*itr)->players.size();
-
-                for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->isInvitedToBgInstanceGuid)
-                        qHorde += (*itr)->players.size();
 
                 // Show queue status to player only (when joining queue)
                 if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN) == 1)
@@ -303,8 +303,6 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // Player *plr = sObjectMgr.GetPlayer(guid);
     // std::lock_guard<std::recursive_mutex> guard(m_Lock);
 
-    int32 bracketId = -1;                                   // signed for proper for-loop finish
-
     // remove player from map, if he's there
     QueuedPlayersMap::iterator itr = m_queuedPlayers.find(guid);
     if (itr == m_queuedPlayers.end())
@@ -314,34 +312,14 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.groupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = GetTeamIndexByTeamId(group->groupTeam);
+    BattleGroundBracketId bracketId = group->bracketId;
+    uint32 index = group->queueIndex;
 
-    for (int8 bracketIdTmp = MAX_BATTLEGROUND_BRACKETS - 1; bracketIdTmp >= 0 && bracketId == -1; --bracketIdTmp)
-    {
-        // we must check premade and normal team's queue - because when players from premade are joining bg,
-        // they leave groupinfo so we can't use its players size to find out index
-        for (uint8 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (GroupsQueueType::iterator group_itr_tmp = m_queuedGroups[bracketIdTmp][j].begin(); group_itr_tmp != m_queuedGroups[bracketIdTmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracketId = bracketIdTmp;
-                    group_itr = group_itr_tmp;
-                    // we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
+    GroupsQueueType& queuedGroups = m_queuedGroups[bracketId][index];
+    GroupsQueueType::iterator group_itr = std::find(queuedGroups.begin(), queuedGroups.end(), group);
 
     // player can't be in queue without group, but just in case
-    if (bracketId == -1)
+    if (group_itr == queuedGroups.end())
     {
         sLog.outError("BattleGroundQueue: ERROR Cannot find groupinfo for %s", guid.GetString().c_str());
         return;
@@ -356,7 +334,11 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove player queue info from group queue info
     GroupQueueInfoPlayers::iterator pitr = group->players.find(guid);
     if (pitr != group->players.end())
+    {
         group->players.erase(pitr);
+        if (!group->isInvitedToBgInstanceGuid)
+            --m_waitingPlayers[bracketId][index];
+    }
 
     // if invited to bg, and should decrease invited count, then do it
     if (decreaseInvitedCount && group->isInvitedToBgInstanceGuid)
@@ -372,7 +354,7 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->players.empty())
     {
-        m_queuedGroups[bracketId][index].erase(group_itr);
+        queuedGroups.erase(group_itr);
         delete group;
     }
 }
@@ -429,6 +411,7 @@ bool BattleGroundQueue::InviteGroupToBg(GroupQueueInfo* queueInfo, BattleGround*
         // not yet invited
         // set invitation
         queueInfo->isInvitedToBgInstanceGuid = bg->GetInstanceId();
+        m_waitingPlayers[queueInfo->bracketId][queueInfo->queueIndex] -= queueInfo->players.size();
         BattleGroundTypeId bgTypeId = bg->GetTypeId();
         BattleGroundQueueTypeId bgQueueTypeId = BattleGroundMgr::BgQueueTypeId(bgTypeId);
         BattleGroundBracketId bracket_id = bg->GetBracketId();
@@ -617,8 +600,12 @@ bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracketId, uint3
             if (!(*itr)->isInvitedToBgInstanceGuid && ((*itr)->joinTime < time_before || (*itr)->players.size() < minPlayersPerTeam))
             {
                 // we must insert group to normal queue and erase pointer from premade queue
-                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
+                GroupQueueInfo* queueInfo = *itr;
+                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].push_front(queueInfo);
                 m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                queueInfo->queueIndex = BG_QUEUE_NORMAL_ALLIANCE + i;
+                m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i] -= queueInfo->players.size();
+                m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i] += queueInfo->players.size();
             }
         }
     }
@@ -637,6 +624,11 @@ bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracketId, uint3
 */
 bool BattleGroundQueue::CheckNormalMatch(BattleGroundBracketId bracketId, uint32 minPlayers, uint32 maxPlayers)
 {
+    // not enough waiting players on one of sides, no need to walk the queues
+    if (!sBattleGroundMgr.IsTesting() &&
+            (m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE] < minPlayers || m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE] < minPlayers))
+        return false;
+
     GroupsQueueType::const_iterator itr_team[PVP_TEAM_COUNT];
     for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
     {
@@ -695,17 +687,20 @@ bool BattleGroundQueue::CheckNormalMatch(BattleGroundBracketId bracketId, uint32
 void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId)
 {
     // std::lock_guard<std::recursive_mutex> guard(m_Lock);
-    // if no players in queue - do nothing
-    if (m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
-            m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty() &&
-            m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-            m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].empty())
+    // if no players waiting for invite in queue - do nothing
+    if (!m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_ALLIANCE] &&
+            !m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_HORDE] &&
+            !m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE] &&
+            !m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE])
         return;
 
+    // running battlegrounds are filled from normal queues only
+    bool const hasNormalWaiting = m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE] || m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE];
+
     // battleground with free slot for player should be always in the beggining of the queue
     // maybe it would be better to create bgfreeslotqueue for each bracket_id
     BgFreeSlotQueueType::iterator next;
-    for (BgFreeSlotQueueType::iterator itr = sBattleGroundMgr.BgFreeSlotQueue[bgTypeId].begin(); itr != sBattleGroundMgr.BgFreeSlotQueue[bgTypeId].end(); itr = next)
+    for (BgFreeSlotQueueType::iterator itr = sBattleGroundMgr.BgFreeSlotQueue[bgTypeId].begin(); hasNormalWaiting && itr != sBattleGroundMgr.BgFreeSlotQueue[bgTypeId].end(); itr = next)
     {
         next = itr;
         ++next;
@@ -24,6 +24,7 @@
 #include "BattleGround.h"
 
 #include <mutex>
+#include <deque>
 
 typedef std::map<uint32, BattleGround*> BattleGroundSet;
 
@@ -53,6 +54,8 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  joinTime;                                       // time when group was added
     uint32  removeInviteTime;                               // time when we will remove invite for players in group
     uint32  isInvitedToBgInstanceGuid;                      // was invited to certain BG
+    BattleGroundBracketId bracketId;                        // queue bucket the group is stored in
+    uint8   queueIndex;                                     // BattleGroundQueueGroupTypes
 };
 
 enum BattleGroundQueueGroupTypes
@@ -93,7 +96,7 @@ class BattleGroundQueue
         QueuedPlayersMap m_queuedPlayers;
 
         // we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
+        typedef std::deque<GroupQueueInfo*> GroupsQueueType;
 
         /*
         This two dimensional array is used to store All queued groups
@@ -106,6 +109,9 @@ class BattleGroundQueue
         */
         GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // count of not yet invited players in each of m_queuedGroups
+        uint32 m_waitingPlayers[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -109,6 +109,7 @@ void Channel::Join(Player* player, const char* password)
 
     PlayerInfo& pinfo = m_players[guid];
     pinfo.player = guid;
+    pinfo.session = player->GetSession();
     pinfo.flags = MEMBER_FLAG_NONE;
 
     MakeYouJoined(data, m_name, *this);
@@ -147,7 +148,7 @@ void Channel::Leave(Player* player, bool send)
         data.clear();
     }
 
-    bool changeowner = m_players[guid].IsOwner();
+    bool changeowner = HasPlayerFlag(guid, MEMBER_FLAG_OWNER);
 
     m_players.erase(guid);
 
@@ -180,7 +181,7 @@ void Channel::KickOrBan(Player* player, const char* targetName, bool ban)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR) && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -250,7 +251,7 @@ void Channel::UnBan(Player* player, const char* targetName)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR) && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -299,7 +300,7 @@ void Channel::SetPassword(Player* player, const char* password)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR) && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -336,7 +337,7 @@ void Channel::SetModeFlags(Player* player, const char* targetName, ChannelMember
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR) && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -503,7 +504,8 @@ void Channel::SendChannelListResponse(Player* player, bool/* display = false*/)
     uint32 count = 0;
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
     {
-        if (Player* member = sObjectMgr.GetPlayer(i->first))
+        Player* member = i->second.session->GetPlayer();
+        if (member && member->IsInWorld())
         {
             if (visibilityCheck && (member->GetSession()->GetSecurity() > visibilityThreshold || !member->IsVisibleGloballyFor(player)))
                 continue;
@@ -534,7 +536,7 @@ void Channel::ToggleAnnouncements(Player* player)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR) && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -569,7 +571,7 @@ void Channel::ToggleModeration(Player* player)
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
 
-    if (!m_players[guid].IsModerator() && !gm)
+    if (!HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR) && !gm)
     {
         WorldPacket data;
         MakeNotModerator(data, m_name);
@@ -604,7 +606,7 @@ void Channel::Say(Player* player, const char* text, uint32 lang)
         return;
     }
 
-    if (m_players[guid].IsMuted() ||
+    if (HasPlayerFlag(guid, MEMBER_FLAG_MUTED) ||
             (GetChannelId() == CHANNEL_ID_LOCAL_DEFENSE && player->GetHonorRankInfo().visualRank < SPEAK_IN_LOCALDEFENSE_RANK) ||
             (GetChannelId() == CHANNEL_ID_WORLD_DEFENSE && player->GetHonorRankInfo().visualRank < SPEAK_IN_WORLDDEFENSE_RANK))
     {
@@ -614,7 +616,7 @@ void Channel::Say(Player* player, const char* text, uint32 lang)
         return;
     }
 
-    const bool moderator = m_players[guid].IsModerator();
+    const bool moderator = HasPlayerFlag(guid, MEMBER_FLAG_MODERATOR);
 
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_MODERATION);
     const bool gm = (level && player->GetSession()->GetSecurity() >= level);
@@ -717,22 +719,27 @@ void Channel::Invite(Player* player, const char* targetName)
 
 void Channel::SendToOne(WorldPacket const& data, ObjectGuid receiver) const
 {
-    if (Player* player = sObjectMgr.GetPlayer(receiver))
+    PlayerList::const_iterator itr = m_players.find(receiver);
+    if (itr != m_players.end())
+        itr->second.session->SendPacket(data);
+    else if (Player* player = sObjectMgr.GetPlayer(receiver))
         player->GetSession()->SendPacket(data);
 }
 
 void Channel::SendToAll(WorldPacket const& data) const
 {
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        SendToOne(data, i->first);
+        i->second.session->SendPacket(data);
 }
 
 void Channel::SendMessage(WorldPacket const& data, ObjectGuid sender) const
 {
+    // members ignoring the sender, usually none
+    SocialListerSet const* ignoredBy = sender ? sSocialMgr.GetIgnoredBy(sender.GetCounter()) : nullptr;
+
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!sender || !plr->GetSocial()->HasIgnore(sender))
-                plr->GetSession()->SendPacket(data);
+        if (!ignoredBy || ignoredBy->find(i->first.GetCounter()) == ignoredBy->end())
+            i->second.session->SendPacket(data);
 }
 
 void Channel::MakeNotifyPacket(WorldPacket& data, const std::string& channel, ChatNotify type)
@@ -952,10 +959,11 @@ void Channel::SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set)
     // Restrict input flags to currently supported by this method
     flags = ChannelMemberFlags(uint8(flags) & (MEMBER_FLAG_MODERATOR | MEMBER_FLAG_MUTED));
 
-    if (flags && m_players[guid].HasFlag(flags) != set)
+    PlayerList::iterator p_itr = m_players.find(guid);
+    if (flags && p_itr != m_players.end() && p_itr->second.HasFlag(flags) != set)
     {
-        uint8 oldFlag = GetPlayerFlags(guid);
-        m_players[guid].SetFlag(flags, set);
+        uint8 oldFlag = p_itr->second.flags;
+        p_itr->second.SetFlag(flags, set);
 
         WorldPacket data;
         MakeModeChange(data, m_name, guid, oldFlag, GetPlayerFlags(guid));
@@ -985,13 +993,14 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
     m_ownerGuid = guid;
 
-    if (m_ownerGuid)
+    PlayerList::iterator p_itr = m_players.find(m_ownerGuid);
+    if (p_itr != m_players.end())
     {
         // new owner receives moderator powers as well
-        m_players[m_ownerGuid].SetModerator(true);
+        p_itr->second.SetModerator(true);
 
-        uint8 oldFlag = GetPlayerFlags(m_ownerGuid);
-        m_players[m_ownerGuid].SetOwner(true);
+        uint8 oldFlag = p_itr->second.flags;
+        p_itr->second.SetOwner(true);
 
         WorldPacket data;
         MakeModeChange(data, m_name, guid, oldFlag, GetPlayerFlags(guid));
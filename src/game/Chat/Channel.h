@@ -127,7 +127,10 @@ class Channel
 
         struct PlayerInfo
         {
+            PlayerInfo() : session(nullptr), flags(0) {}
+
             ObjectGuid player;
+            WorldSession* session;                          // valid while member, players leave all channels at logout
             uint8 flags;
 
             inline bool HasFlag(uint8 flag) const { return (flags & flag) != 0; }
@@ -234,6 +237,8 @@ class Channel
             return p_itr->second.flags;
         }
 
+        bool HasPlayerFlag(ObjectGuid guid, uint8 flag) const { return (GetPlayerFlags(guid) & flag) != 0; }
+
         ObjectGuid SelectNewOwner() const;
 
         void SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set);
@@ -75,7 +75,50 @@ bool WorldSession::CheckChatMessage(std::string& msg, bool addon/* = false*/)
     return true;
 }
 
+// say, yell and emote only reach players around the speaker and may be handled in Map::Update(),
+// commands, whispers, group, guild and channel chat touch global state and are left to the world thread
+static bool IsMapLocalChatMessage(WorldPacket& recv_data)
+{
+    uint32 type;
+    uint32 lang;
+    recv_data >> type;
+    recv_data >> lang;
+
+    bool local = false;
+    if (type == CHAT_MSG_SAY || type == CHAT_MSG_EMOTE || type == CHAT_MSG_YELL)
+    {
+        std::string msg;
+        recv_data >> msg;
+        local = msg.empty() || (msg[0] != '.' && msg[0] != '!');
+    }
+
+    recv_data.rpos(0);
+    return local;
+}
+
 void WorldSession::HandleMessagechatOpcode(WorldPacket& recv_data)
+{
+    if (IsMapLocalChatMessage(recv_data))
+    {
+        ProcessMessagechat(recv_data);
+        return;
+    }
+
+    uint32 accountId = GetAccountId();
+    ObjectGuid playerGuid = _player->GetObjectGuid();
+    WorldPacket packet(recv_data);
+    sWorld.GetMessager().AddMessage([accountId, playerGuid, packet](World* world)
+    {
+        WorldSession* session = world->FindSession(accountId);
+        if (!session || !session->GetPlayer() || session->GetPlayer()->GetObjectGuid() != playerGuid)
+            return;
+
+        WorldPacket data(packet);
+        session->ProcessMessagechat(data);
+    });
+}
+
+void WorldSession::ProcessMessagechat(WorldPacket& recv_data)
 {
     uint32 type;
     uint32 lang;
@@ -28,6 +28,7 @@
 #include "AI/BaseAI/CreatureAI.h"
 #include "Entities/GameObject.h"
 #include "Server/Opcodes.h"
+#include "Server/OpcodeProfiler.h"
 #include "Chat/Chat.h"
 #include "Globals/ObjectAccessor.h"
 #include "Maps/MapManager.h"
@@ -4479,6 +4480,49 @@ bool ChatHandler::HandleServerCorpsesCommand(char* /*args*/)
     return true;
 }
 
+/// Show the opcodes with the highest handler time since the last reset
+bool ChatHandler::HandleServerOpcodesCommand(char* args)
+{
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    OpcodeProfileList profiles;
+    sOpcodeProfiler.GetProfiles(profiles);
+
+    std::vector<uint16> opcodes;
+    for (uint32 i = 0; i < profiles.size(); ++i)
+        if (profiles[i].handled || profiles[i].sentPackets)
+            opcodes.push_back(i);
+
+    std::sort(opcodes.begin(), opcodes.end(), [&profiles](uint16 a, uint16 b)
+    {
+        if (profiles[a].handlerTime != profiles[b].handlerTime)
+            return profiles[a].handlerTime > profiles[b].handlerTime;
+        return profiles[a].sentBytes > profiles[b].sentBytes;
+    });
+
+    if (opcodes.size() > limit)
+        opcodes.resize(limit);
+
+    SendSysMessage("Opcode: handled, total us, p50 us, p99 us / sent packets, sent bytes");
+    for (uint16 opcode : opcodes)
+    {
+        OpcodeProfile const& profile = profiles[opcode];
+        PSendSysMessage("%s: " UI64FMTD ", " UI64FMTD ", " UI64FMTD ", " UI64FMTD " / " UI64FMTD ", " UI64FMTD,
+                        LookupOpcodeName(opcode), profile.handled, profile.handlerTime,
+                        profile.GetPercentile(0.5), profile.GetPercentile(0.99), profile.sentPackets, profile.sentBytes);
+    }
+    return true;
+}
+
+bool ChatHandler::HandleServerOpcodesResetCommand(char* /*args*/)
+{
+    sOpcodeProfiler.Reset();
+    SendSysMessage("Opcode statistics reset.");
+    return true;
+}
+
 bool ChatHandler::HandleRepairitemsCommand(char* args)
 {
     Player* target;
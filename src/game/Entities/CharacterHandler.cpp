@@ -40,6 +40,8 @@
 #include "Chat/Chat.h"
 #include "Spells/SpellMgr.h"
 
+#include <chrono>
+
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotMgr.h"
 #endif
@@ -57,11 +59,13 @@ class LoginQueryHolder : public SqlQueryHolder
     private:
         uint32 m_accountId;
         ObjectGuid m_guid;
+        std::chrono::steady_clock::time_point m_createTime;
     public:
         LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-            : m_accountId(accountId), m_guid(guid) { }
+            : m_accountId(accountId), m_guid(guid), m_createTime(std::chrono::steady_clock::now()) { }
         ObjectGuid GetGuid() const { return m_guid; }
         uint32 GetAccountId() const { return m_accountId; }
+        std::chrono::steady_clock::time_point GetCreateTime() const { return m_createTime; }
         bool Initialize();
 };
 
@@ -536,6 +540,8 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 
     SetOnline();
 
+    auto loadStart = std::chrono::steady_clock::now();
+
     // "GetAccountId()==db stored account id" checked in LoadFromDB (prevent login not own character using cheating tools)
     if (!pCurrChar->LoadFromDB(playerGuid, holder))
     {
@@ -552,6 +558,10 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
         return;
     }
 
+    auto loadEnd = std::chrono::steady_clock::now();
+    sWorld.RecordPlayerLogin(std::chrono::duration_cast<std::chrono::microseconds>(loadStart - holder->GetCreateTime()).count(),
+                             std::chrono::duration_cast<std::chrono::microseconds>(loadEnd - loadStart).count());
+
     pCurrChar->GetMotionMaster()->Initialize();
 
     Group* group = pCurrChar->GetGroup();
@@ -521,6 +521,8 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     // group is initialized in the reference constructor
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
+    m_groupUpdateDelay = 0;
+    m_groupPositionUpdateDelay = 0;
 
     ClearHonorInfo();
 
@@ -1532,7 +1534,7 @@ void Player::Update(const uint32 diff)
         m_createdInstanceClearTimer -= diff;
 
     // Group update
-    SendUpdateToOutOfRangeGroupMembers();
+    SendUpdateToOutOfRangeGroupMembers(diff);
 
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityDistance()) && (GetCharmGuid() && (pet->GetObjectGuid() != GetCharmGuid())))
@@ -17765,13 +17767,31 @@ void Player::SendInitialPacketsAfterAddToMap()
     SendItemDurations();                                    // must be after add to map
 }
 
-void Player::SendUpdateToOutOfRangeGroupMembers()
+void Player::SendUpdateToOutOfRangeGroupMembers(uint32 diff)
 {
+    m_groupUpdateDelay = m_groupUpdateDelay > diff ? m_groupUpdateDelay - diff : 0;
+    m_groupPositionUpdateDelay = m_groupPositionUpdateDelay > diff ? m_groupPositionUpdateDelay - diff : 0;
+
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
+
+    // accumulate frequent changes (health, power, auras, movement) and send them as one packet per interval
+    if (!(m_groupUpdateMask & GROUP_UPDATE_URGENT))
+    {
+        if (m_groupUpdateDelay)
+            return;
+
+        if (m_groupUpdateMask == GROUP_UPDATE_FLAG_POSITION && m_groupPositionUpdateDelay)
+            return;
+    }
+
     if (Group* group = GetGroup())
         group->UpdatePlayerOutOfRange(this);
 
+    m_groupUpdateDelay = sWorld.getConfig(CONFIG_UINT32_GROUP_STATS_UPDATE_INTERVAL);
+    if (m_groupUpdateMask & GROUP_UPDATE_FLAG_POSITION)
+        m_groupPositionUpdateDelay = sWorld.getConfig(CONFIG_UINT32_GROUP_POSITION_UPDATE_INTERVAL);
+
     m_groupUpdateMask = GROUP_UPDATE_FLAG_NONE;
     ResetAuraUpdateMask();
     if (Unit* charm = GetCharm())
@@ -1577,7 +1577,7 @@ class Player : public Unit
         void UninviteFromGroup();
         static void RemoveFromGroup(Group* group, ObjectGuid guid);
         void RemoveFromGroup() { RemoveFromGroup(GetGroup(), GetObjectGuid()); }
-        void SendUpdateToOutOfRangeGroupMembers();
+        void SendUpdateToOutOfRangeGroupMembers(uint32 diff);
 
         void SetInGuild(uint32 GuildId) { SetUInt32Value(PLAYER_GUILDID, GuildId); }
         void SetRank(uint32 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
@@ -2429,6 +2429,8 @@ class Player : public Unit
         GroupReference m_originalGroup;
         Group* m_groupInvite;
         uint32 m_groupUpdateMask;
+        uint32 m_groupUpdateDelay;                          // time left before throttled stats changes are sent
+        uint32 m_groupPositionUpdateDelay;                  // time left before a position only change is sent
 
         // Player summoning
         time_t m_summon_expire;
@@ -85,7 +85,8 @@ void MapManager::LoadTransports()
             continue;
         }
 
-        float x = t->m_WayPoints[0].x; float y = t->m_WayPoints[0].y; float z = t->m_WayPoints[0].z; uint32 mapid = t->m_WayPoints[0].mapid; float o = 1;
+        auto const& start = t->m_WayPoints[0].second;
+        float x = start.x; float y = start.y; float z = start.z; uint32 mapid = start.mapid; float o = 1;
 
         // current code does not support transports in dungeon!
         const MapEntry* pMapInfo = sMapStore.LookupEntry(mapid);
@@ -138,7 +139,7 @@ void MapManager::LoadTransports()
     sLog.outString();
 }
 
-Transport::Transport() : GameObject(), m_pathTime(0), m_timer(0), m_nextNodeTime(0), m_period(0)
+Transport::Transport() : GameObject(), m_currIndex(0), m_pathTime(0), m_timer(0), m_nextNodeTime(0), m_period(0)
 {
     m_updateFlag = (UPDATEFLAG_TRANSPORT | UPDATEFLAG_ALL | UPDATEFLAG_HAS_POSITION);
 }
@@ -187,6 +188,9 @@ bool Transport::Create(uint32 guidlow, uint32 mapid, float x, float y, float z,
     return true;
 }
 
+// steps of 100 ms between two stored path samples
+#define PATH_SAMPLE_STEPS 10
+
 struct keyFrame
 {
     explicit keyFrame(TaxiPathNodeEntry const& _node) : node(&_node),
@@ -315,8 +319,11 @@ bool Transport::GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids)
         teleport = true;
 
     WayPoint pos(keyFrames[0].node->mapid, keyFrames[0].node->x, keyFrames[0].node->y, keyFrames[0].node->z, teleport);
-    m_WayPoints[0] = pos;
+    AddWayPoint(0, pos);
+    m_pathSamples.emplace_back(0, pos.mapid, pos.x, pos.y, pos.z);
     t += keyFrames[0].node->delay * 1000;
+    if (keyFrames[0].node->delay)
+        m_pathSamples.emplace_back(t, pos.mapid, pos.x, pos.y, pos.z);
 
     uint32 cM = keyFrames[0].node->mapid;
     for (size_t i = 0; i < keyFrames.size() - 1; ++i)
@@ -325,9 +332,11 @@ bool Transport::GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids)
         float tFrom = keyFrames[i].tFrom;
         float tTo = keyFrames[i].tTo;
 
-        // keep the generation of all these points; we use only a few now, but may need the others later
+        // keep the generation of all these points; only teleports become waypoints, the others are sampled
+        // every PATH_SAMPLE_STEPS steps so the position between waypoints can be interpolated
         if (((d < keyFrames[i + 1].distFromPrev) && (tTo > 0)))
         {
+            uint32 step = 0;
             while ((d < keyFrames[i + 1].distFromPrev) && (tTo > 0))
             {
                 tFrom += 100;
@@ -349,7 +358,11 @@ bool Transport::GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids)
                     //                    sLog.outString("T: %d, D: %f, x: %f, y: %f, z: %f", t, d, newX, newY, newZ);
                     pos = WayPoint(keyFrames[i].node->mapid, newX, newY, newZ, teleport2);
                     if (teleport2)
-                        m_WayPoints[t] = pos;
+                        AddWayPoint(t, pos);
+
+                    if (teleport2 || step % PATH_SAMPLE_STEPS == 0)
+                        m_pathSamples.emplace_back(t, pos.mapid, pos.x, pos.y, pos.z);
+                    ++step;
                 }
 
                 if (tFrom < tTo)                            // caught in tFrom dock's "gravitational pull"
@@ -397,9 +410,12 @@ bool Transport::GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids)
         //        sLog.outString("T: %d, x: %f, y: %f, z: %f, t:%d", t, pos.x, pos.y, pos.z, teleport);
 
         // if (teleport)
-        m_WayPoints[t] = pos;
+        AddWayPoint(t, pos);
+        m_pathSamples.emplace_back(t, pos.mapid, pos.x, pos.y, pos.z);
 
         t += keyFrames[i + 1].node->delay * 1000;
+        if (keyFrames[i + 1].node->delay)
+            m_pathSamples.emplace_back(t, pos.mapid, pos.x, pos.y, pos.z);
         //        sLog.outString("------");
     }
 
@@ -407,24 +423,66 @@ bool Transport::GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids)
 
     //    sLog.outDetail("    Generated %lu waypoints, total time %u.", (unsigned long)m_WayPoints.size(), timer);
 
-    m_next = m_WayPoints.begin();                           // will used in MoveToNextWayPoint for init m_curr
-    MoveToNextWayPoint();                                   // m_curr -> first point
-    MoveToNextWayPoint();                                   // skip first point
+    m_WayPoints.shrink_to_fit();
+    m_pathSamples.shrink_to_fit();
+
+    m_currIndex = 1 % m_WayPoints.size();                   // skip first point
 
     m_pathTime = timer;
 
-    m_nextNodeTime = m_curr->first;
+    m_nextNodeTime = m_WayPoints[m_currIndex].first;
 
     return true;
 }
 
-void Transport::MoveToNextWayPoint()
+void Transport::AddWayPoint(uint32 pathTime, WayPoint const& pos)
+{
+    // waypoints are generated in time order, a waypoint at the same time replaces the previous one
+    WayPointList::iterator itr = std::lower_bound(m_WayPoints.begin(), m_WayPoints.end(), pathTime,
+        [](std::pair<uint32, WayPoint> const& wp, uint32 time) { return wp.first < time; });
+    if (itr != m_WayPoints.end() && itr->first == pathTime)
+        itr->second = pos;
+    else
+        m_WayPoints.emplace(itr, pathTime, pos);
+}
+
+size_t Transport::FindWayPointIndex(uint32 pathTime) const
+{
+    WayPointList::const_iterator itr = std::upper_bound(m_WayPoints.begin(), m_WayPoints.end(), pathTime,
+        [](uint32 time, std::pair<uint32, WayPoint> const& wp) { return time < wp.first; });
+
+    // before the first waypoint we are still on the way from the last one of the previous period
+    if (itr == m_WayPoints.begin())
+        return m_WayPoints.size() - 1;
+
+    return size_t(itr - m_WayPoints.begin()) - 1;
+}
+
+bool Transport::GetPathPosition(uint32 pathTime, float& x, float& y, float& z) const
 {
-    m_curr = m_next;
+    PathSampleList::const_iterator next = std::upper_bound(m_pathSamples.begin(), m_pathSamples.end(), pathTime,
+        [](uint32 time, PathSample const& sample) { return time < sample.time; });
+    if (next == m_pathSamples.begin())
+        return false;
+
+    PathSample const& prev = *(next - 1);
+    if (prev.mapid != GetMapId())
+        return false;
+
+    x = prev.x;
+    y = prev.y;
+    z = prev.z;
+
+    // samples are taken along straight segments, interpolate unless the transport changes map in between
+    if (next != m_pathSamples.end() && next->mapid == prev.mapid && next->time > prev.time)
+    {
+        float frac = float(pathTime - prev.time) / float(next->time - prev.time);
+        x += (next->x - prev.x) * frac;
+        y += (next->y - prev.y) * frac;
+        z += (next->z - prev.z) * frac;
+    }
 
-    ++m_next;
-    if (m_next == m_WayPoints.end())
-        m_next = m_WayPoints.begin();
+    return true;
 }
 
 void Transport::TeleportTransport(uint32 newMapid, float x, float y, float z)
@@ -491,36 +549,41 @@ void Transport::Update(const uint32 /*diff*/)
         return;
 
     m_timer = WorldTimer::getMSTime() % m_period;
-    while (((m_timer - m_curr->first) % m_pathTime) > ((m_next->first - m_curr->first) % m_pathTime))
+    uint32 pathTimer = m_timer % m_pathTime;
+
+    size_t index = FindWayPointIndex(pathTimer);
+    if (index == m_currIndex)
     {
-        MoveToNextWayPoint();
+        // between two waypoints, follow the path
+        float x, y, z;
+        if (GetPathPosition(pathTimer, x, y, z))
+            Relocate(x, y, z);
+        return;
+    }
 
-        // first check help in case client-server transport coordinates de-synchronization
-        if (m_curr->second.mapid != GetMapId() || m_curr->second.teleport)
-        {
-            TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
-        }
-        else
-        {
-            Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z);
-        }
+    // all waypoints passed since last update are applied at once, a single teleport covers the map changes in between
+    bool teleport = false;
+    for (size_t i = m_currIndex; i != index && !teleport;)
+    {
+        i = (i + 1) % m_WayPoints.size();
+        teleport = m_WayPoints[i].second.teleport;
+    }
 
-        /*
-        for(PlayerSet::const_iterator itr = m_passengers.begin(); itr != m_passengers.end();)
-        {
-            PlayerSet::const_iterator it2 = itr;
-            ++itr;
-            //(*it2)->SetPosition( m_curr->second.x + (*it2)->GetTransOffsetX(), m_curr->second.y + (*it2)->GetTransOffsetY(), m_curr->second.z + (*it2)->GetTransOffsetZ(), (*it2)->GetTransOffsetO() );
-        }
-        */
+    m_currIndex = index;
+    WayPoint const& curr = m_WayPoints[m_currIndex].second;
+
+    // first check help in case client-server transport coordinates de-synchronization
+    if (curr.mapid != GetMapId() || teleport)
+        TeleportTransport(curr.mapid, curr.x, curr.y, curr.z);
+    else
+        Relocate(curr.x, curr.y, curr.z);
 
-        m_nextNodeTime = m_curr->first;
+    m_nextNodeTime = m_WayPoints[m_currIndex].first;
 
-        if (m_curr == m_WayPoints.begin())
-            DETAIL_FILTER_LOG(LOG_FILTER_TRANSPORT_MOVES, " ************ BEGIN ************** %s", GetName());
+    if (m_currIndex == 0)
+        DETAIL_FILTER_LOG(LOG_FILTER_TRANSPORT_MOVES, " ************ BEGIN ************** %s", GetName());
 
-        DETAIL_FILTER_LOG(LOG_FILTER_TRANSPORT_MOVES, "%s moved to %f %f %f %d", GetName(), m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
-    }
+    DETAIL_FILTER_LOG(LOG_FILTER_TRANSPORT_MOVES, "%s moved to %f %f %f %d", GetName(), curr.x, curr.y, curr.z, curr.mapid);
 }
 
 void Transport::UpdateForMap(Map const* targetMap)
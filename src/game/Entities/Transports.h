@@ -21,8 +21,8 @@
 
 #include "Entities/GameObject.h"
 
-#include <map>
 #include <set>
+#include <vector>
 
 class Transport : public GameObject
 {
@@ -52,23 +52,40 @@ class Transport : public GameObject
             bool teleport;
         };
 
-        typedef std::map<uint32, WayPoint> WayPointMap;
+        // Position along the path at a given path time, used to follow the path between two waypoints
+        struct PathSample
+        {
+            PathSample(uint32 _time, uint32 _mapid, float _x, float _y, float _z) :
+                time(_time), mapid(_mapid), x(_x), y(_y), z(_z) {}
 
-        WayPointMap::const_iterator m_curr;
-        WayPointMap::const_iterator m_next;
+            uint32 time;
+            uint32 mapid;
+            float x;
+            float y;
+            float z;
+        };
+
+        typedef std::vector<std::pair<uint32 /*pathTime*/, WayPoint> > WayPointList;
+        typedef std::vector<PathSample> PathSampleList;
+
+        size_t m_currIndex;                                 // last waypoint reached in m_WayPoints
         uint32 m_pathTime;
         uint32 m_timer;
 
+        PathSampleList m_pathSamples;                       // sorted by time, precomputed by GenerateWaypoints
+
         PlayerSet m_passengers;
 
     public:
-        WayPointMap m_WayPoints;
+        WayPointList m_WayPoints;                           // sorted by path time
         uint32 m_nextNodeTime;
         uint32 m_period;
 
     private:
         void TeleportTransport(uint32 newMapid, float x, float y, float z);
         void UpdateForMap(Map const* targetMap);
-        void MoveToNextWayPoint();                          // move m_next/m_cur to next points
+        void AddWayPoint(uint32 pathTime, WayPoint const& pos);
+        size_t FindWayPointIndex(uint32 pathTime) const;    // last waypoint at or before pathTime
+        bool GetPathPosition(uint32 pathTime, float& x, float& y, float& z) const;
 };
 #endif
@@ -66,6 +66,9 @@ uint32 GameEventMgr::NextCheck(uint16 entry) const
 void GameEventMgr::StartEvent(uint16 event_id, bool overwrite /*=false*/, bool resume /*=false*/)
 {
     ApplyNewEvent(event_id, resume);
+    if (!m_inUpdate)
+        SendSpawnChangesToMaps();
+
     if (overwrite)
     {
         m_gameEvents[event_id].start = time(nullptr);
@@ -77,6 +80,9 @@ void GameEventMgr::StartEvent(uint16 event_id, bool overwrite /*=false*/, bool r
 void GameEventMgr::StopEvent(uint16 event_id, bool overwrite)
 {
     UnApplyEvent(event_id);
+    if (!m_inUpdate)
+        SendSpawnChangesToMaps();
+
     if (overwrite)
     {
         m_gameEvents[event_id].start = time(nullptr) - m_gameEvents[event_id].length * MINUTE;
@@ -648,6 +654,9 @@ uint32 GameEventMgr::Update(ActiveEvents const* activeAtShutdown /*= nullptr*/)
 {
     time_t currenttime = time(nullptr);
 
+    // all transitions of this update are sent together to the maps
+    m_inUpdate = true;
+
     uint32 nextEventDelay = max_ge_check_delay;             // 1 day
     for (uint16 itr = 1; itr < m_gameEvents.size(); ++itr)
     {
@@ -689,6 +698,10 @@ uint32 GameEventMgr::Update(ActiveEvents const* activeAtShutdown /*= nullptr*/)
         if (calcDelay < nextEventDelay)
             nextEventDelay = calcDelay;
     }
+
+    m_inUpdate = false;
+    SendSpawnChangesToMaps();
+
     BASIC_LOG("Next game event check in %u seconds.", nextEventDelay + 1);
     return (nextEventDelay + 1) * IN_MILLISECONDS;          // Add 1 second to be sure event has started/stopped at next call
 }
@@ -776,7 +789,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddCreatureToGrid(itr, data);
 
-            Creature::SpawnInMaps(itr, data);
+            m_creatureSpawnChanges[itr] = true;
         }
     }
 
@@ -806,7 +819,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddGameobjectToGrid(itr, data);
 
-            GameObject::SpawnInMaps(itr, data);
+            m_gameobjectSpawnChanges[itr] = true;
         }
     }
 
@@ -853,7 +866,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveCreatureFromGrid(itr, data);
 
             // Remove spawned cases
-            Creature::AddToRemoveListInMaps(itr, data);
+            m_creatureSpawnChanges[itr] = false;
         }
     }
 
@@ -883,7 +896,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveGameobjectFromGrid(itr, data);
 
             // Remove spawned cases
-            GameObject::AddToRemoveListInMaps(itr, data);
+            m_gameobjectSpawnChanges[itr] = false;
         }
     }
 
@@ -926,42 +939,128 @@ GameEventCreatureData const* GameEventMgr::GetCreatureUpdateDataForActiveEvent(u
     return nullptr;
 }
 
-struct GameEventUpdateCreatureDataInMapsWorker
+void GameEventMgr::UpdateCreatureData(int16 event_id, bool activate)
 {
-    GameEventUpdateCreatureDataInMapsWorker(ObjectGuid guid, CreatureData const* data, GameEventCreatureData* event_data, bool activate)
-        : i_guid(guid), i_data(data), i_event_data(event_data), i_activate(activate) {}
+    for (auto& itr : m_gameEventCreatureData[event_id])
+        m_creatureDataChanges.push_back(std::make_pair(itr.first, std::make_pair(&itr.second, activate)));
+}
 
-    void operator()(Map* map)
+// The static spawn data is already updated, the spawned objects are changed by the maps themselves in their updates
+// (at most GameEvent.SpawnsPerUpdate changes per map update), so big events do not stall the world update.
+// An object whose state is already the wanted one in a map (grid loaded since, change reverted...) is skipped.
+void GameEventMgr::SendSpawnChangesToMaps()
+{
+    for (auto const& change : m_creatureSpawnChanges)
     {
-        if (Creature* pCreature = map->GetCreature(i_guid))
+        CreatureData const* data = sObjectMgr.GetCreatureData(change.first);
+        if (!data)
+            continue;
+
+        uint32 dbGuid = change.first;
+        ObjectGuid guid = data->GetObjectGuid(dbGuid);
+        bool spawn = change.second;
+        sMapMgr.DoForAllMapsWithMapId(data->mapid, [dbGuid, guid, spawn](Map* targetMap)
         {
-            pCreature->UpdateEntry(i_data->id, i_data, i_activate ? i_event_data : nullptr);
+            targetMap->GetSpawnMessager().AddMessage([dbGuid, guid, spawn](Map* map)
+            {
+                Creature* creature = map->GetCreature(guid);
+                if (!spawn)
+                {
+                    if (creature)
+                        creature->AddObjectToRemoveList();
+                    return;
+                }
 
-            // spells not casted for event remove case (sent nullptr into update), do it
-            if (!i_activate)
-                pCreature->ApplyGameEventSpells(i_event_data, false);
-        }
+                // a despawn of this tick only put it in the remove list, finish it so the spawn is not lost
+                if (creature)
+                {
+                    map->RemoveAllObjectsInRemoveList();
+                    creature = map->GetCreature(guid);
+                }
+
+                CreatureData const* spawnData = sObjectMgr.GetCreatureData(dbGuid);
+                // We use spawn coords to spawn
+                if (creature || !spawnData || !map->IsLoaded(spawnData->posX, spawnData->posY))
+                    return;
+
+                creature = new Creature;
+                if (!creature->LoadFromDB(dbGuid, map))
+                    delete creature;
+            });
+        });
     }
+    m_creatureSpawnChanges.clear();
+
+    for (auto const& change : m_gameobjectSpawnChanges)
+    {
+        GameObjectData const* data = sObjectMgr.GetGOData(change.first);
+        if (!data)
+            continue;
 
-    ObjectGuid i_guid;
-    CreatureData const* i_data;
-    GameEventCreatureData* i_event_data;
-    bool i_activate;
-};
+        uint32 dbGuid = change.first;
+        ObjectGuid guid = ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, dbGuid);
+        bool spawn = change.second;
+        sMapMgr.DoForAllMapsWithMapId(data->mapid, [dbGuid, guid, spawn](Map* targetMap)
+        {
+            targetMap->GetSpawnMessager().AddMessage([dbGuid, guid, spawn](Map* map)
+            {
+                GameObject* gameobject = map->GetGameObject(guid);
+                if (!spawn)
+                {
+                    if (gameobject)
+                        gameobject->AddObjectToRemoveList();
+                    return;
+                }
 
-void GameEventMgr::UpdateCreatureData(int16 event_id, bool activate)
-{
-    for (auto& itr : m_gameEventCreatureData[event_id])
+                // a despawn of this tick only put it in the remove list, finish it so the spawn is not lost
+                if (gameobject)
+                {
+                    map->RemoveAllObjectsInRemoveList();
+                    gameobject = map->GetGameObject(guid);
+                }
+
+                GameObjectData const* spawnData = sObjectMgr.GetGOData(dbGuid);
+                // Spawn if necessary (loaded grids only)
+                if (gameobject || !spawnData || !map->IsLoaded(spawnData->posX, spawnData->posY))
+                    return;
+
+                gameobject = new GameObject;
+                if (!gameobject->LoadFromDB(dbGuid, map))
+                    delete gameobject;
+                else
+                    map->Add(gameobject);
+            });
+        });
+    }
+    m_gameobjectSpawnChanges.clear();
+
+    // equipment and model changes, in transition order after the spawns
+    for (auto const& change : m_creatureDataChanges)
     {
-        // Remove the creature from grid
-        CreatureData const* data = sObjectMgr.GetCreatureData(itr.first);
+        CreatureData const* data = sObjectMgr.GetCreatureData(change.first);
         if (!data)
             continue;
 
-        // Update if spawned
-        GameEventUpdateCreatureDataInMapsWorker worker(data->GetObjectGuid(itr.first), data, &itr.second, activate);
-        sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
+        ObjectGuid guid = data->GetObjectGuid(change.first);
+        GameEventCreatureData const* eventData = change.second.first;
+        bool activate = change.second.second;
+        sMapMgr.DoForAllMapsWithMapId(data->mapid, [guid, data, eventData, activate](Map* targetMap)
+        {
+            targetMap->GetSpawnMessager().AddMessage([guid, data, eventData, activate](Map* map)
+            {
+                // Update if spawned
+                if (Creature* creature = map->GetCreature(guid))
+                {
+                    creature->UpdateEntry(data->id, data, activate ? eventData : nullptr);
+
+                    // spells not casted for event remove case (sent nullptr into update), do it
+                    if (!activate)
+                        creature->ApplyGameEventSpells(eventData, false);
+                }
+            });
+        });
     }
+    m_creatureDataChanges.clear();
 }
 
 void GameEventMgr::UpdateEventQuests(uint16 event_id, bool Activate)
@@ -1040,6 +1139,7 @@ int16 GameEventMgr::GetGameEventId<Pool>(uint32 guid_or_poolid)
 GameEventMgr::GameEventMgr()
 {
     m_isGameEventsInit = false;
+    m_inUpdate = false;
 }
 
 bool GameEventMgr::IsActiveHoliday(HolidayIds id) const
@@ -23,6 +23,8 @@
 #include "Globals/SharedDefines.h"
 #include "Platform/Define.h"
 
+#include <unordered_map>
+
 #define max_ge_check_delay 86400                            // 1 day in seconds
 #define FAR_FUTURE 1609459200                               // 2021, January 1st
 
@@ -120,6 +122,7 @@ class GameEventMgr
         void SendEventMails(int16 event_id);
         void OnEventHappened(uint16 event_id, bool activate, bool resume);
         void ComputeEventStartAndEndTime(GameEventData& data);
+        void SendSpawnChangesToMaps();
     protected:
         typedef std::list<uint32> GuidList;
         typedef std::list<uint16> IdList;
@@ -148,6 +151,15 @@ class GameEventMgr
         GameEventDataMap  m_gameEvents;
         ActiveEvents m_activeEvents;
         bool m_isGameEventsInit;
+
+        // Changes of the spawned state of event objects made by the event transitions in progress, only the final state
+        // of each object is sent to its maps (see SendSpawnChangesToMaps)
+        typedef std::unordered_map<uint32 /*db guid*/, bool /*spawned*/> SpawnChangeMap;
+        typedef std::vector<std::pair<uint32 /*db guid*/, std::pair<GameEventCreatureData const*, bool /*activate*/> > > CreatureDataChangeList;
+        SpawnChangeMap m_creatureSpawnChanges;
+        SpawnChangeMap m_gameobjectSpawnChanges;
+        CreatureDataChangeList m_creatureDataChanges;
+        bool m_inUpdate;
 };
 
 #define sGameEventMgr MaNGOS::Singleton<GameEventMgr>::Instance()
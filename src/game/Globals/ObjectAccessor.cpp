@@ -38,30 +38,41 @@ INSTANTIATE_CLASS_MUTEX(ObjectAccessor, std::mutex);
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap[o->GetObjectGuid()] = o;
+    Shard& shard = GetShard(o->GetObjectGuid());
+    WriteGuard guard(shard.lock);
+    shard.objectMap[o->GetObjectGuid()] = o;
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap.erase(o->GetObjectGuid());
+    Shard& shard = GetShard(o->GetObjectGuid());
+    WriteGuard guard(shard.lock);
+    shard.objectMap.erase(o->GetObjectGuid());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    ReadGuard guard(i_lock);
-    typename MapType::iterator itr = m_objectMap.find(guid);
-    return (itr != m_objectMap.end()) ? itr->second : nullptr;
+    Shard& shard = GetShard(guid);
+    ReadGuard guard(shard.lock);
+    typename MapType::iterator itr = shard.objectMap.find(guid);
+    return (itr != shard.objectMap.end()) ? itr->second : nullptr;
 }
 
 template<class T>
-typename HashMapHolder<T>::MapType& HashMapHolder<T>::GetContainer() { return m_objectMap; }
-
-template<class T>
-typename HashMapHolder<T>::LockType& HashMapHolder<T>::GetLock() { return i_lock; }
+typename HashMapHolder<T>::ListType HashMapHolder<T>::GetAll()
+{
+    ListType list;
+    for (Shard& shard : m_shards)
+    {
+        ReadGuard guard(shard.lock);
+        list.reserve(list.size() + shard.objectMap.size());
+        for (auto& itr : shard.objectMap)
+            list.push_back(itr.second);
+    }
+    return list;
+}
 
 ObjectAccessor::ObjectAccessor() {}
 ObjectAccessor::~ObjectAccessor()
@@ -113,22 +124,50 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && (::strcmp(name, iter->second->GetName()) == 0))
-            return iter->second;
+    std::string key = name;
+    if (!normalizePlayerName(key))
+        return nullptr;
+
+    ObjectAccessor& accessor = sObjectAccessor;
+    boost::shared_lock<boost::shared_mutex> guard(accessor.i_playerNamesGuard);
+    PlayerNameMapType::const_iterator itr = accessor.i_playerNames.find(key);
+    if (itr == accessor.i_playerNames.end() || !itr->second->IsInWorld())
+        return nullptr;
+
+    return itr->second;
+}
+
+void ObjectAccessor::AddObject(Player* object)
+{
+    HashMapHolder<Player>::Insert(object);
+
+    std::string key = object->GetName();
+    if (!normalizePlayerName(key))
+        return;
+
+    boost::unique_lock<boost::shared_mutex> guard(i_playerNamesGuard);
+    i_playerNames[key] = object;
+}
+
+void ObjectAccessor::RemoveObject(Player* object)
+{
+    HashMapHolder<Player>::Remove(object);
+
+    std::string key = object->GetName();
+    if (!normalizePlayerName(key))
+        return;
 
-    return nullptr;
+    boost::unique_lock<boost::shared_mutex> guard(i_playerNamesGuard);
+    PlayerNameMapType::iterator itr = i_playerNames.find(key);
+    if (itr != i_playerNames.end() && itr->second == object)
+        i_playerNames.erase(itr);
 }
 
 void
 ObjectAccessor::SaveAllPlayers() const
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (auto& itr : m)
-        itr.second->SaveToDB();
+    for (Player* player : GetPlayers())
+        player->SaveToDB();
 }
 
 void ObjectAccessor::KickPlayer(ObjectGuid guid)
@@ -295,8 +334,7 @@ void ObjectAccessor::RemoveOldCorpses()
 
 /// Define the static member of HashMapHolder
 
-template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> std::mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HashMapHolder<T>::SHARD_COUNT];
 
 /// Global definitions for the hashmap storage
 
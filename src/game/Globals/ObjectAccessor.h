@@ -32,20 +32,27 @@
 #include "Entities/Corpse.h"
 
 #include <mutex>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
 
 class Unit;
 class WorldObject;
 class Map;
 
+// Objects are spread over SHARD_COUNT independently locked maps so lookups from
+// different map threads rarely meet on the same lock, and never block each other
 template <class T>
 class HashMapHolder
 {
     public:
 
+        enum { SHARD_COUNT = 16 };                          // must be power of 2
+
         typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        typedef std::vector<T*>                      ListType;
+        typedef boost::shared_mutex LockType;
+        typedef boost::shared_lock<LockType> ReadGuard;
+        typedef boost::unique_lock<LockType> WriteGuard;
 
         static void Insert(T* o);
 
@@ -53,17 +60,23 @@ class HashMapHolder
 
         static T* Find(ObjectGuid guid);
 
-        static MapType& GetContainer();
-
-        static LockType& GetLock();
+        // copy of all stored objects, each shard is read locked only while it is copied
+        static ListType GetAll();
 
     private:
 
+        struct Shard
+        {
+            LockType lock;
+            MapType  objectMap;
+        };
+
         // Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        static Shard& GetShard(ObjectGuid guid) { return m_shards[guid.GetCounter() & (SHARD_COUNT - 1)]; }
+
+        static Shard m_shards[SHARD_COUNT];
 };
 
 class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, std::mutex> >
@@ -87,9 +100,9 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         static Player* FindPlayerByName(const char* name);
         static void KickPlayer(ObjectGuid guid);
 
-        HashMapHolder<Player>::MapType& GetPlayers() const
+        HashMapHolder<Player>::ListType GetPlayers() const
         {
-            return HashMapHolder<Player>::GetContainer();
+            return HashMapHolder<Player>::GetAll();
         }
 
         void SaveAllPlayers() const;
@@ -105,13 +118,18 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse* object) { HashMapHolder<Corpse>::Insert(object); }
-        void AddObject(Player* object) { HashMapHolder<Player>::Insert(object); }
+        void AddObject(Player* object);
         void RemoveObject(Corpse* object) { HashMapHolder<Corpse>::Remove(object); }
-        void RemoveObject(Player* object) { HashMapHolder<Player>::Remove(object); }
+        void RemoveObject(Player* object);
 
     private:
 
+        // normalized (see normalizePlayerName) name -> player
+        typedef std::unordered_map<std::string, Player*> PlayerNameMapType;
+
         Player2CorpsesMapType   i_player2corpse;
+        PlayerNameMapType       i_playerNames;
+        boost::shared_mutex     i_playerNamesGuard;
 
         typedef std::mutex LockType;
         typedef MaNGOS::GeneralLock<LockType > Guard;
@@ -18,6 +18,7 @@
 
 #include "Globals/ObjectMgr.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Policies/Singleton.h"
 
 #include "Server/SQLStorages.h"
@@ -53,6 +54,8 @@
 #include <limits>
 #include <cstdarg>
 
+static uint32 const EXPIRED_MAILS_CHUNK_SIZE = 1000;       // expired mails fetched by one async query
+
 INSTANTIATE_SINGLETON_1(ObjectMgr);
 
 bool normalizePlayerName(std::string& name, size_t max_len)
@@ -108,12 +111,13 @@ LanguageDesc const* GetLanguageDescByID(uint32 lang)
 template<typename T>
 T IdGenerator<T>::Generate()
 {
-    if (m_nextGuid >= std::numeric_limits<T>::max() - 1)
+    T id = m_nextGuid++;
+    if (id >= std::numeric_limits<T>::max() - 1)
     {
         sLog.outError("%s guid overflow!! Can't continue, shutting down server. ", m_name);
         World::StopNow(ERROR_EXIT_CODE);
     }
-    return m_nextGuid++;
+    return id;
 }
 
 template uint32 IdGenerator<uint32>::Generate();
@@ -128,7 +132,12 @@ ObjectMgr::ObjectMgr() :
     m_GroupIds("Group ids"),
     m_FirstTemporaryCreatureGuid(1),
     m_FirstTemporaryGameObjectGuid(1),
-    DBCLocaleIndex(LOCALE_enUS)
+    DBCLocaleIndex(LOCALE_enUS),
+    m_expiredMailsTime(0),
+    m_expiredMailsLastId(0),
+    m_expiredMailsQueryPending(false),
+    m_expiredMailsHasMore(false),
+    m_expiredMailsCount(0)
 {
 }
 
@@ -152,6 +161,9 @@ ObjectMgr::~ObjectMgr()
     for (auto& itr : mGroupMap)
         delete itr.second;
 
+    for (auto& m_expiredMail : m_expiredMails)
+        delete m_expiredMail;
+
     for (auto& itr : m_mCacheVendorTemplateItemMap)
         itr.second.Clear();
 
@@ -5134,9 +5146,22 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
     time_t basetime = time(nullptr);
     DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    // at server run expired mails are fetched in chunks by async queries and processed by UpdateExpiredMails
+    if (serverUp)
+    {
+        if (m_expiredMailsTime)
+            return;                                         // previous run not finished yet
+
+        m_expiredMailsTime = basetime;
+        m_expiredMailsLastId = 0;
+        m_expiredMailsCount = 0;
+        RequestExpiredMails();
+        return;
+    }
+
     // delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND itemTextId = 0", (uint64)basetime);
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND itemTextId = 0", (uint64)basetime);
     //                                                     0  1           2      3        4          5         6           7   8       9
     QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,itemTextId,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
     if (!result)
@@ -5148,11 +5173,6 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         return;                                             // any mails need to be returned or deleted
     }
 
-    // std::ostringstream delitems, delmails; // will be here for optimization
-    // bool deletemail = false, deleteitem = false;
-    // delitems << "DELETE FROM item_instance WHERE guid IN ( ";
-    // delmails << "DELETE FROM mail WHERE id IN ( "
-
     BarGoLink bar(result->GetRowCount());
     uint32 count = 0;
 
@@ -5166,25 +5186,15 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         m->messageType = fields[1].GetUInt8();
         m->sender = fields[2].GetUInt32();
         m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
-        bool has_items = fields[5].GetBool();
+        m->itemTextId = fields[4].GetUInt32();
+        m->has_items = fields[5].GetBool();
         m->expire_time = (time_t)fields[6].GetUInt64();
         m->deliver_time = 0;
         m->COD = fields[7].GetUInt32();
         m->checked = fields[8].GetUInt32();
         m->mailTemplateId = fields[9].GetInt16();
 
-        Player* pl = nullptr;
-        if (serverUp)
-            pl = GetPlayer(m->receiverGuid);
-        if (pl)
-        {
-            // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            // his in mailbox and he has already listed his mails )
-            delete m;
-            continue;
-        }
-        // delete or return mail:
-        if (has_items)
+        if (m->has_items)
         {
             QueryResult* resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
             if (resultItems)
@@ -5202,37 +5212,11 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 
                 delete resultItems;
             }
-            // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
-            {
-                // mail open and then not returned
-                for (auto& item : m->items)
-                    CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", item.item_guid);
-            }
-            else
-            {
-                // mail will be returned:
-                CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'",
-                                           m->receiverGuid.GetCounter(), m->sender, (uint64)basetime + 30 * DAY, (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, itr2->item_guid);
-                }
-                delete m;
-                continue;
-            }
         }
 
-        if (m->itemTextId)
-            CharacterDatabase.PExecute("DELETE FROM item_text WHERE id = '%u'", m->itemTextId);
-
-        // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
+        if (ReturnOrDeleteOldMail(m, basetime))
+            ++count;
         delete m;
-        ++count;
     }
     while (result->NextRow());
     delete result;
@@ -5241,6 +5225,138 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
     sLog.outString();
 }
 
+void ObjectMgr::RequestExpiredMails()
+{
+    m_expiredMailsQueryPending = true;
+
+    // one chunk of expired mails with their items, rows of one mail are adjacent
+    //                                                                                                  0    1             2        3          4            5           6         7            8
+    CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ExpiredMailsQueryCallback, uint64(m_expiredMailsTime), "SELECT m.id,m.messageType,m.sender,m.receiver,m.itemTextId,m.has_items,m.checked,mi.item_guid,mi.item_template FROM "
+                                  "(SELECT id,messageType,sender,receiver,itemTextId,has_items,checked FROM mail WHERE expire_time < '" UI64FMTD "' AND id > '%u' ORDER BY id LIMIT %u) m "
+                                  "LEFT JOIN mail_items mi ON mi.mail_id = m.id ORDER BY m.id",
+                                  (uint64)m_expiredMailsTime, m_expiredMailsLastId, EXPIRED_MAILS_CHUNK_SIZE);
+}
+
+void ObjectMgr::ExpiredMailsQueryCallback(QueryResult* result, uint64 basetime)
+{
+    if (basetime != uint64(m_expiredMailsTime))
+    {
+        delete result;                                      // not expected, job must not restart while a query is pending
+        return;
+    }
+
+    m_expiredMailsQueryPending = false;
+    m_expiredMailsHasMore = false;
+
+    if (!result)
+        return;
+
+    uint32 mails = 0;
+    Mail* m = nullptr;
+    do
+    {
+        Field* fields = result->Fetch();
+        uint32 mailId = fields[0].GetUInt32();
+        if (!m || m->messageID != mailId)
+        {
+            m = new Mail;
+            m->messageID = mailId;
+            m->messageType = fields[1].GetUInt8();
+            m->sender = fields[2].GetUInt32();
+            m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+            m->itemTextId = fields[4].GetUInt32();
+            m->has_items = fields[5].GetBool();
+            m->checked = fields[6].GetUInt32();
+            m->expire_time = m_expiredMailsTime;
+            m->deliver_time = 0;
+            m->COD = 0;
+            m->mailTemplateId = 0;
+
+            m_expiredMails.push_back(m);
+            m_expiredMailsLastId = mailId;
+            ++mails;
+        }
+
+        if (!fields[7].IsNULL())
+            m->AddItem(fields[7].GetUInt32(), fields[8].GetUInt32());
+    }
+    while (result->NextRow());
+    delete result;
+
+    m_expiredMailsHasMore = mails >= EXPIRED_MAILS_CHUNK_SIZE;
+}
+
+void ObjectMgr::UpdateExpiredMails()
+{
+    if (!m_expiredMailsTime)
+        return;
+
+    if (!m_expiredMails.empty())
+    {
+        // the writes of one tick are sent as one transaction
+        CharacterDatabase.BeginTransaction();
+        for (uint32 budget = sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_PER_TICK); budget > 0 && !m_expiredMails.empty(); --budget)
+        {
+            Mail* m = m_expiredMails.front();
+            m_expiredMails.pop_front();
+
+            // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+            // his in mailbox and he has already listed his mails )
+            if (!GetPlayer(m->receiverGuid) && ReturnOrDeleteOldMail(m, m_expiredMailsTime))
+                ++m_expiredMailsCount;
+
+            delete m;
+        }
+        CharacterDatabase.CommitTransaction();
+    }
+
+    if (!m_expiredMails.empty() || m_expiredMailsQueryPending)
+        return;
+
+    if (m_expiredMailsHasMore)
+    {
+        RequestExpiredMails();
+        return;
+    }
+
+    DETAIL_LOG("Expired mails processed, %u mails deleted", m_expiredMailsCount);
+    m_expiredMailsTime = 0;
+}
+
+bool ObjectMgr::ReturnOrDeleteOldMail(Mail const* m, time_t basetime)
+{
+    // delete or return mail:
+    if (m->has_items)
+    {
+        // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+        {
+            // mail open and then not returned
+            for (auto const& item : m->items)
+                CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", item.item_guid);
+        }
+        else
+        {
+            // mail will be returned:
+            CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'",
+                                       m->receiverGuid.GetCounter(), m->sender, (uint64)basetime + 30 * DAY, (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
+            for (auto const& item : m->items)
+            {
+                // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m->sender, item.item_guid);
+                CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, item.item_guid);
+            }
+            return false;
+        }
+    }
+
+    if (m->itemTextId)
+        CharacterDatabase.PExecute("DELETE FROM item_text WHERE id = '%u'", m->itemTextId);
+
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
+    return true;
+}
+
 void ObjectMgr::LoadQuestAreaTriggers()
 {
     mQuestAreaTriggerMap.clear();                           // need for reload case
@@ -455,7 +455,7 @@ class IdGenerator
 
     private:                                                // fields
         char const* m_name;
-        T m_nextGuid;
+        std::atomic<T> m_nextGuid;                          // pet numbers are generated from several map threads
 };
 
 class ObjectMgr
@@ -772,6 +772,7 @@ class ObjectMgr
         void LoadStandingList();
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        void UpdateExpiredMails();                          // per tick part of ReturnOrDeleteOldMails(true)
 
         void SetHighestGuids();
 
@@ -1248,6 +1249,10 @@ class ObjectMgr
         PlayerClassInfo playerClassInfo[MAX_CLASSES];
 
         void BuildPlayerLevelInfo(uint8 race, uint8 _class, uint8 level, PlayerLevelInfo* info) const;
+
+        void RequestExpiredMails();
+        void ExpiredMailsQueryCallback(QueryResult* result, uint64 basetime);
+        bool ReturnOrDeleteOldMail(Mail const* m, time_t basetime); // true if mail deleted, false if returned
         PlayerInfo playerInfo[MAX_RACES][MAX_CLASSES];
 
         typedef std::vector<uint32> PlayerXPperLevel;       // [level]
@@ -1305,6 +1310,14 @@ class ObjectMgr
         CacheTrainerSpellMap m_mCacheTrainerSpellMap;
 
         BroadcastTextMap m_broadcastTextMap;
+
+        // expired mails of the running ReturnOrDeleteOldMails(true) job, fetched in chunks by async queries
+        std::deque<Mail*> m_expiredMails;
+        time_t m_expiredMailsTime;                          // expiration time of the running job, 0 if none
+        uint32 m_expiredMailsLastId;                        // highest mail id fetched, next chunk starts after it
+        bool m_expiredMailsQueryPending;
+        bool m_expiredMailsHasMore;
+        uint32 m_expiredMailsCount;
 };
 
 #define sObjectMgr MaNGOS::Singleton<ObjectMgr>::Instance()
@@ -271,8 +271,15 @@ ObjectGridUnloader::Visit(GridRefManager<T>& m)
             obj->SaveRespawnTime();
         ///- object must be out of world before delete
         obj->RemoveFromWorld();
-        ///- object will get delinked from the manager when deleted
-        delete obj;
+
+        if (sWorld.getConfig(CONFIG_UINT32_GRID_UNLOAD_DELETE_PER_UPDATE))
+        {
+            ///- detach it from the grid now, the map deletes it in one of its next updates
+            obj->GetGridRef().unlink();
+            obj->GetMap()->AddUnloadedObject(obj);
+        }
+        else
+            delete obj;                                     // object will get delinked from the manager when deleted
     }
 }
 
@@ -594,13 +594,19 @@ void Group::UpdatePlayerOutOfRange(Player* pPlayer)
     if (pPlayer->GetGroupUpdateFlag() == GROUP_UPDATE_FLAG_NONE)
         return;
 
+    // built only once, and only if some member really needs it
     WorldPacket data;
-    WorldSession::BuildPartyMemberStatsChangedPacket(pPlayer, data);
-
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
-        if (Player* player = itr->getSource())
-            if (player != pPlayer && !player->HaveAtClient(pPlayer))
-                player->GetSession()->SendPacket(data);
+    {
+        Player* player = itr->getSource();
+        if (!player || player == pPlayer || player->HaveAtClient(pPlayer))
+            continue;
+
+        if (data.empty())
+            WorldSession::BuildPartyMemberStatsChangedPacket(pPlayer, data);
+
+        player->GetSession()->SendPacket(data);
+    }
 }
 
 void Group::UpdatePlayerOnlineStatus(Player* player, bool online /*= true*/)
@@ -85,6 +85,11 @@ enum GroupUpdateFlags
 
     GROUP_UPDATE_PET                    = 0x0007FC00,       // all pet flags
     GROUP_UPDATE_FULL                   = 0x0007FFFF,       // all known flags
+
+    // changes sent to out of range members without waiting for Group.StatsUpdateInterval
+    GROUP_UPDATE_URGENT                 = GROUP_UPDATE_FLAG_STATUS | GROUP_UPDATE_FLAG_POWER_TYPE | GROUP_UPDATE_FLAG_LEVEL |
+                                          GROUP_UPDATE_FLAG_ZONE | GROUP_UPDATE_FLAG_PET_GUID | GROUP_UPDATE_FLAG_PET_NAME |
+                                          GROUP_UPDATE_FLAG_PET_MODEL_ID | GROUP_UPDATE_FLAG_PET_POWER_TYPE,
 };
 
 #define GROUP_UPDATE_FLAGS_COUNT          20
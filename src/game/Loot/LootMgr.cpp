@@ -29,6 +29,7 @@
 #include "Entities/ItemEnchantmentMgr.h"
 #include "Entities/Corpse.h"
 #include "Tools/Language.h"
+#include "Metric/Metric.h"
 #include <sstream>
 #include <iomanip>
 
@@ -62,17 +63,29 @@ class LootTemplate::LootGroup                               // A set of loot def
         bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
         bool HasQuestDropForPlayer(Player const* player) const;
         // The same for active quests of the player
-        void Process(Loot& loot, Player const* lootOwner) const; // Rolls an item from the group (if any) and adds the item to the loot
+        void Process(Loot& loot, Player const* lootOwner, bool legacyRoll) const; // Rolls an item from the group (if any) and adds the item to the loot
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
 
         void Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const;
         void CheckLootRefs(LootIdSet* ref_set) const;
+        void Compile();                                     // Builds the alias table and lookup data used by Roll (at loading stage)
+        bool DependsOnLooter() const;                       // True if rolled items or their loot right depend on the looters state
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
-        LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const; // Rolls an item from the group, returns nullptr if all miss their chances
+        // Walker alias table of the explicitly chanced part, the last column stands for "no drop from this part".
+        // Only built when the part can be rolled by a single draw: total chance not above 100%.
+        std::vector<float>  AliasChance;
+        std::vector<uint32> AliasIndex;
+        std::vector<uint32> EqualChancedItemIds;            // sorted item ids of the equal chanced part
+        bool ExplicitlyChancedHasConditions = false;
+        bool EqualChancedHasConditions = false;
+
+        LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner, bool legacyRoll) const; // Rolls an item from the group, returns nullptr if all miss their chances
+        LootStoreItem const* RollExplicitlyChanced(Loot const& loot, Player const* lootOwner) const;
+        LootStoreItem const* RollEqualChanced(Loot const& loot, Player const* lootOwner) const;
 };
 
 // Remove all data and free all memory
@@ -173,6 +186,10 @@ void LootStore::LoadLootTable()
 
         Verify();                                           // Checks validity of the loot store
 
+        for (auto& lootTemplate : m_LootTemplates)
+            lootTemplate.second->Compile();
+        LinkReferences();
+
         sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, m_LootTemplates.size(), GetName());
         sLog.outString();
     }
@@ -243,6 +260,15 @@ void LootStore::ReportNotExistedId(uint32 id) const
     sLog.outErrorDb("Table '%s' entry %d (%s) not exist but used as loot id in DB.", GetName(), id, GetEntryName());
 }
 
+void LootStore::LinkReferences()
+{
+    for (auto& lootTemplate : m_LootTemplates)
+        lootTemplate.second->LinkReferences();
+
+    for (auto& lootTemplate : m_LootTemplates)
+        lootTemplate.second->UpdateLooterIndependence();
+}
+
 //
 // --------- LootStoreItem ---------
 //
@@ -394,6 +420,44 @@ LootItem::LootItem(uint32 _itemId, uint32 _count, uint32 _randomSuffix, int32 _r
     isReleased        = false;
 }
 
+// Loot is generated and destroyed at a high rate by the map threads (AoE farming, raid clears), so released
+// LootItem blocks are kept in a small per thread free list instead of going back to the allocator every time.
+// Short lived threads (auction house bot preparation) also use it, so the cached blocks are freed at thread exit.
+struct LootItemPool
+{
+    static uint32 const Capacity = 256;
+
+    LootItemPool() : size(0) {}
+    ~LootItemPool()
+    {
+        while (size > 0)
+            ::operator delete(blocks[--size]);
+    }
+
+    void*  blocks[Capacity];
+    uint32 size;
+};
+
+static thread_local LootItemPool lootItemPool;
+
+void* LootItem::operator new(size_t size)
+{
+    if (size == sizeof(LootItem) && lootItemPool.size > 0)
+        return lootItemPool.blocks[--lootItemPool.size];
+
+    return ::operator new(size);
+}
+
+void LootItem::operator delete(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    if (lootItemPool.size < LootItemPool::Capacity)
+        lootItemPool.blocks[lootItemPool.size++] = ptr;
+    else
+        ::operator delete(ptr);
+}
 
 // Basic checks for player/item compatibility - if false no chance to see the item in the loot
 bool LootItem::AllowedForPlayer(Player const* player, WorldObject const* lootTarget) const
@@ -429,6 +493,12 @@ bool LootItem::AllowedForPlayer(Player const* player, WorldObject const* lootTar
     return true;
 }
 
+// True if AllowedForPlayer can't fail whatever the player state is
+bool LootItem::IsAllowedForAnyPlayer() const
+{
+    return itemProto && lootItemType == LOOTITEM_TYPE_NORMAL && !itemProto->StartQuest;
+}
+
 LootSlotType LootItem::GetSlotTypeForSharedLoot(Player const* player, Loot const* loot) const
 {
     // Check if still have right to pick this item
@@ -899,21 +969,26 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
     tab->Process(*this, lootOwner, store, store.IsRatesAllowed()); // Processing is done there, callback via Loot::AddItem()
 
     // fill the loot owners right here so its impossible from this point to change loot result
-    Player* masterLooter = nullptr;
-    if (m_lootMethod == MASTER_LOOT)
-        masterLooter = ObjectAccessor::FindPlayer(m_masterOwnerGuid);
+    SetItemsLootRight(m_lootMethod == MASTER_LOOT && ObjectAccessor::FindPlayer(m_masterOwnerGuid), false);
+    return true;
+}
 
-    for (auto playerGuid : m_ownerSet)
+// Set loot right of the generated items
+// For deferred generation only the owners found at loot creation get rights (see DeferItemsGeneration), the ones
+// that went offline since keep them only for items that do not need the player to be checked
+void Loot::SetItemsLootRight(bool masterLooterFound, bool deferred)
+{
+    for (auto playerGuid : deferred ? m_deferredOwnerSet : m_ownerSet)
     {
         Player* player = ObjectAccessor::FindPlayer(playerGuid);
 
         // assign permission for non chest items
         for (auto lootItem : m_lootItems)
         {
-            if (player && (lootItem->AllowedForPlayer(player, GetLootTarget())))
+            if (player ? lootItem->AllowedForPlayer(player, GetLootTarget()) : (deferred && lootItem->IsAllowedForAnyPlayer()))
             {
                 if (!m_isChest)
-                    lootItem->allowedGuid.emplace(player->GetObjectGuid());
+                    lootItem->allowedGuid.emplace(playerGuid);
             }
             else
             {
@@ -936,7 +1011,7 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
                 case MASTER_LOOT:
                 {
                     // roll item if masterloot is not in the list or if masterloot have no right for this item
-                    if (!masterLooter || lootItem->allowedGuid.find(m_masterOwnerGuid) == lootItem->allowedGuid.end())
+                    if (!masterLooterFound || lootItem->allowedGuid.find(m_masterOwnerGuid) == lootItem->allowedGuid.end())
                         lootItem->isBlocked = true;
                     break;
                 }
@@ -953,10 +1028,61 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
             }
         }
     }
+}
+
+// Only keep what is needed to generate the items later, at first access of the loot
+// Allowed only when the result can't depend on the moment it is generated: the template does not depend on
+// the looters state and the corpse is lootable anyway (it contains money) so its lootable flag is already known.
+bool Loot::DeferItemsGeneration(uint32 loot_id, LootStore const& store, Player* lootOwner)
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_LOOT_DEFERRED_GENERATION) || !m_gold || !lootOwner)
+        return false;
+
+    LootTemplate const* tab = store.GetLootFor(loot_id);
+    if (!tab || !tab->IsLooterIndependent())
+        return false;
 
+    m_deferredStore = &store;
+    m_deferredLootId = loot_id;
+    m_deferredSeed = urand();
+    m_deferredMasterLooterFound = m_lootMethod == MASTER_LOOT && ObjectAccessor::FindPlayer(m_masterOwnerGuid);
+
+    // owners not found now would not get any right with immediate generation
+    m_deferredOwnerSet.clear();
+    for (auto playerGuid : m_ownerSet)
+        if (ObjectAccessor::FindPlayer(playerGuid))
+            m_deferredOwnerSet.insert(playerGuid);
+
+    sLootMgr.IncrementDeferredLootCounter();
     return true;
 }
 
+// Generate the items of a loot created with deferred generation (if not already done)
+void Loot::GenerateDeferredItems()
+{
+    if (!m_deferredStore)
+        return;
+
+    LootStore const& store = *m_deferredStore;
+    m_deferredStore = nullptr;
+
+    LootTemplate const* tab = store.GetLootFor(m_deferredLootId);
+    if (!tab)
+        return;                                             // table reloaded meanwhile
+
+    m_lootItems.reserve(MAX_NR_LOOT_ITEMS);
+
+    // the items only depend on the seed taken at loot creation, not on the moment they are generated
+    std::mt19937& generator = *GetRandomGenerator();
+    std::mt19937 savedGenerator = generator;
+    generator.seed(m_deferredSeed);
+    tab->Process(*this, nullptr, store, store.IsRatesAllowed());
+    generator = savedGenerator;
+
+    SetItemsLootRight(m_deferredMasterLooterFound, true);
+    m_deferredOwnerSet.clear();
+}
+
 // Get loot status for a specified player
 uint32 Loot::GetLootStatusFor(Player const* player) const
 {
@@ -1385,6 +1511,8 @@ void Loot::Release(Player* player)
 // Popup windows with loot content
 void Loot::ShowContentTo(Player* plr)
 {
+    GenerateDeferredItems();
+
     if (!m_isChest)
     {
         // for item loot that might be empty we should not display error but instead send empty loot window
@@ -1592,7 +1720,8 @@ void Loot::SetGroupLootRight(Player* player)
 Loot::Loot(Player* player, Creature* creature, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1619,9 +1748,24 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
             SetGroupLootRight(player);
             m_clientLootType = CLIENT_LOOT_CORPSE;
 
-            if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+            bool hasLoot;
+            if (creatureInfo->LootId && LootTemplates_Creature.HaveLootFor(creatureInfo->LootId) && creatureInfo->MaxLootGold > 0 && sWorld.getConfig(CONFIG_BOOL_LOOT_DEFERRED_GENERATION))
             {
+                // money first, it decides if items generation can be deferred
                 GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
+                if (!DeferItemsGeneration(creatureInfo->LootId, LootTemplates_Creature, player))
+                    FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false);
+                hasLoot = true;
+            }
+            else
+            {
+                hasLoot = (creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0;
+                if (hasLoot)
+                    GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
+            }
+
+            if (hasLoot)
+            {
                 // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
                 bool isLootedForAll = IsLootedForAll();
                 if (isLootedForAll)
@@ -1691,7 +1835,8 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
 Loot::Loot(Player* player, GameObject* gameObject, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1778,7 +1923,8 @@ Loot::Loot(Player* player, GameObject* gameObject, LootType type) :
 Loot::Loot(Player* player, Corpse* corpse, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1825,7 +1971,8 @@ Loot::Loot(Player* player, Corpse* corpse, LootType type) :
 Loot::Loot(Player* player, Item* item, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1864,7 +2011,8 @@ Loot::Loot(Player* player, Item* item, LootType type) :
 Loot::Loot(Unit* unit, Item* item) :
     m_lootTarget(nullptr), m_itemTarget(item), m_gold(0), m_maxSlot(0),
     m_lootType(LOOT_SKINNING), m_clientLootType(CLIENT_LOOT_PICKPOCKETING), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0),
-    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
     m_ownerSet.insert(unit->GetObjectGuid());
     m_guidTarget = item->GetObjectGuid();
@@ -1873,7 +2021,8 @@ Loot::Loot(Unit* unit, Item* item) :
 Loot::Loot(Player* player, uint32 id, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
     m_ownerSet.insert(player->GetObjectGuid());
     switch (type)
@@ -1895,7 +2044,8 @@ Loot::Loot(Player* player, uint32 id, LootType type) :
 Loot::Loot(LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime()),
+    m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
 {
 
 }
@@ -2015,6 +2165,8 @@ InventoryResult Loot::SendItem(Player* target, LootItem* lootItem)
 
 bool Loot::AutoStore(Player* player, bool broadcast /*= false*/, uint32 bag /*= NULL_BAG*/, uint32 slot /*= NULL_SLOT*/)
 {
+    GenerateDeferredItems();
+
     bool result = true;
     for (LootItemList::const_iterator lootItemItr = m_lootItems.begin(); lootItemItr != m_lootItems.end(); ++lootItemItr)
     {
@@ -2088,6 +2240,8 @@ void Loot::ForceLootAnimationClientUpdate() const
 // will return the pointer of item in loot slot provided without any right check
 LootItem* Loot::GetLootItemInSlot(uint32 itemSlot)
 {
+    GenerateDeferredItems();
+
     for (auto lootItem : m_lootItems)
     {
         if (lootItem->lootSlot == itemSlot)
@@ -2099,6 +2253,8 @@ LootItem* Loot::GetLootItemInSlot(uint32 itemSlot)
 // Will return available loot item for specific player. Use only for own loot like loot in item and mail
 void Loot::GetLootItemsListFor(Player* player, LootItemList& lootList)
 {
+    GenerateDeferredItems();
+
     for (LootItemList::const_iterator lootItemItr = m_lootItems.begin(); lootItemItr != m_lootItems.end(); ++lootItemItr)
     {
         LootItem* lootItem = *lootItemItr;
@@ -2111,6 +2267,9 @@ void Loot::GetLootItemsListFor(Player* player, LootItemList& lootList)
 
 Loot::~Loot()
 {
+    if (m_deferredStore)
+        sLootMgr.IncrementAvoidedLootCounter();
+
     SendReleaseForAll();
     for (auto& m_lootItem : m_lootItems)
         delete m_lootItem;
@@ -2131,6 +2290,8 @@ void Loot::Clear()
     m_haveItemOverThreshold = false;
     m_isChecked = false;
     m_maxSlot = 0;
+    m_deferredStore = nullptr;
+    m_deferredOwnerSet.clear();
 }
 
 // only used from explicitly loaded loot
@@ -2195,8 +2356,21 @@ bool Loot::IsItemAlreadyIn(uint32 itemId) const
     return false;
 }
 
-void Loot::PrintLootList(ChatHandler& chat, WorldSession* session) const
+// True if at least one of the provided items is already in the loot (sortedItemIds have to be sorted)
+bool Loot::IsAnyItemAlreadyIn(std::vector<uint32> const& sortedItemIds) const
 {
+    for (auto lootItem : m_lootItems)
+    {
+        if (std::binary_search(sortedItemIds.begin(), sortedItemIds.end(), lootItem->itemId))
+            return true;
+    }
+    return false;
+}
+
+void Loot::PrintLootList(ChatHandler& chat, WorldSession* session)
+{
+    GenerateDeferredItems();
+
     if (!session)
     {
         chat.SendSysMessage("Error you have to be in game for this command.");
@@ -2286,75 +2460,168 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
         EqualChanced.push_back(item);
 }
 
-// Rolls an item from the group, returns nullptr if all miss their chances
-LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player const* lootOwner) const
+// Builds the precomputed data used at roll time (at loading stage)
+void LootTemplate::LootGroup::Compile()
 {
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    AliasChance.clear();
+    AliasIndex.clear();
+    EqualChancedItemIds.clear();
+    ExplicitlyChancedHasConditions = false;
+    EqualChancedHasConditions = false;
+
+    float totalChance = 0.0f;
+    for (auto const& entry : ExplicitlyChanced)
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+        totalChance += entry.chance;
+        if (entry.conditionId)
+            ExplicitlyChancedHasConditions = true;
+    }
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : ExplicitlyChanced)
-            lootStoreItemVector.push_back(&itr);
+    for (auto const& entry : EqualChanced)
+    {
+        EqualChancedItemIds.push_back(entry.itemid);
+        if (entry.conditionId)
+            EqualChancedHasConditions = true;
+    }
+    std::sort(EqualChancedItemIds.begin(), EqualChancedItemIds.end());
 
-        // randomize the new vector
-        shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+    // Above 100% the legacy roll depends on the shuffled order of the entries, keep it for such (broken) groups
+    if (ExplicitlyChanced.empty() || totalChance > 100.0f)
+        return;
 
-        float chance = rand_chance_f();
+    // Vose's variant of the Walker alias method, column n is the "no drop" outcome
+    uint32 const columns = ExplicitlyChanced.size() + 1;
+    std::vector<double> scaled(columns);
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        scaled[i] = double(ExplicitlyChanced[i].chance) * columns / 100.0;
+    scaled[columns - 1] = double(100.0f - totalChance) * columns / 100.0;
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
-        {
-            LootStoreItem const* lsi = *itr;
+    AliasChance.resize(columns, 1.0f);
+    AliasIndex.resize(columns);
+    for (uint32 i = 0; i < columns; ++i)
+        AliasIndex[i] = i;
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
-            {
-                sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
-            }
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < columns; ++i)
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
 
-            if (lsi->chance >= 100.0f)
-                return lsi;
+        AliasChance[less] = float(scaled[less]);
+        AliasIndex[less] = more;
 
-            chance -= lsi->chance;
-            if (chance < 0)
-                return lsi;
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
         }
     }
+    // remaining columns are full (only rounding errors left)
+}
 
-    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+// Rolls an item from the explicitly chanced part, legacy processing with per roll shuffling
+LootStoreItem const* LootTemplate::LootGroup::RollExplicitlyChanced(Loot const& loot, Player const* lootOwner) const
+{
+    std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+
+    // fill the new vector with correct pointer to our item list
+    for (auto& itr : ExplicitlyChanced)
+        lootStoreItemVector.push_back(&itr);
+
+    // randomize the new vector
+    shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+
+    float chance = rand_chance_f();
+
+    // as the new vector is randomized we can start from first element and stop at first one that meet the condition
+    for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+        LootStoreItem const* lsi = *itr;
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : EqualChanced)
-            lootStoreItemVector.push_back(&itr);
+        if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+        {
+            sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
+            continue;
+        }
 
-        // randomize the new vector
-        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+        if (lsi->chance >= 100.0f)
+            return lsi;
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+        chance -= lsi->chance;
+        if (chance < 0)
+            return lsi;
+    }
+
+    return nullptr;
+}
+
+// Rolls an item from the equal chanced part, legacy processing with per roll shuffling
+LootStoreItem const* LootTemplate::LootGroup::RollEqualChanced(Loot const& loot, Player const* lootOwner) const
+{
+    std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+
+    // fill the new vector with correct pointer to our item list
+    for (auto& itr : EqualChanced)
+        lootStoreItemVector.push_back(&itr);
+
+    // randomize the new vector
+    std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+
+    // as the new vector is randomized we can start from first element and stop at first one that meet the condition
+    for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+    {
+        LootStoreItem const* lsi = *itr;
+
+        //check if we already have that item in the loot list
+        if (loot.IsItemAlreadyIn(lsi->itemid))
         {
-            LootStoreItem const* lsi = *itr;
+            // the item is already looted, let's give a 50%  chance to pick another one
+            uint32 chance = urand(0, 1);
 
-            //check if we already have that item in the loot list
-            if (loot.IsItemAlreadyIn(lsi->itemid))
-            {
-                // the item is already looted, let's give a 50%  chance to pick another one
-                uint32 chance = urand(0, 1);
+            if (chance)
+                continue;                               // pass this item
+        }
 
-                if (chance)
-                    continue;                               // pass this item
-            }
+        if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+        {
+            sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
+            continue;
+        }
+        return lsi;
+    }
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
-            {
-                sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
-            }
-            return lsi;
+    return nullptr;
+}
+
+// Rolls an item from the group, returns nullptr if all miss their chances
+// The precomputed tables are used whenever they give the exact same distribution as the legacy processing:
+// no condition have to be checked and, for the equal chanced part, none of its items is already in the loot.
+LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player const* lootOwner, bool legacyRoll) const
+{
+    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    {
+        if (!legacyRoll && !AliasChance.empty() && (!lootOwner || !ExplicitlyChancedHasConditions))
+        {
+            uint32 column = urand(0, AliasChance.size() - 1);
+            uint32 selected = rand_norm_f() < AliasChance[column] ? column : AliasIndex[column];
+            if (selected < ExplicitlyChanced.size())
+                return &ExplicitlyChanced[selected];
         }
+        else if (LootStoreItem const* lsi = RollExplicitlyChanced(loot, lootOwner))
+            return lsi;
+    }
+
+    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+    {
+        if (!legacyRoll && (!lootOwner || !EqualChancedHasConditions) && !loot.IsAnyItemAlreadyIn(EqualChancedItemIds))
+            return &EqualChanced[urand(0, EqualChanced.size() - 1)];
+
+        return RollEqualChanced(loot, lootOwner);
     }
 
     return nullptr;                                            // Empty drop from the group
@@ -2385,13 +2652,31 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player) const
 }
 
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
-void LootTemplate::LootGroup::Process(Loot& loot, Player const* lootOwner) const
+void LootTemplate::LootGroup::Process(Loot& loot, Player const* lootOwner, bool legacyRoll) const
 {
-    LootStoreItem const* item = Roll(loot, lootOwner);
+    LootStoreItem const* item = Roll(loot, lootOwner, legacyRoll);
     if (item != nullptr)
         loot.AddItem(*item);
 }
 
+// True if the group contains conditional, quest or quest starting items
+bool LootTemplate::LootGroup::DependsOnLooter() const
+{
+    for (auto const& entries : { &ExplicitlyChanced, &EqualChanced })
+    {
+        for (auto const& entry : *entries)
+        {
+            if (entry.conditionId || entry.needs_quest)
+                return true;
+
+            ItemPrototype const* proto = ObjectMgr::GetItemPrototype(entry.itemid);
+            if (!proto || proto->StartQuest)
+                return true;
+        }
+    }
+    return false;
+}
+
 // Overall chance for the group without equal chanced items
 float LootTemplate::LootGroup::RawTotalChance() const
 {
@@ -2472,44 +2757,46 @@ void LootTemplate::AddEntry(LootStoreItem& item)
 }
 
 // Rolls for every item in the template and adds the rolled items the the loot
-void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId) const
+void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId, bool legacyRoll) const
 {
     if (groupId)                                            // Group reference uses own processing of the group
     {
         if (groupId > Groups.size())
             return;                                         // Error message already printed at loading stage
 
-        Groups[groupId - 1].Process(loot, lootOwner);
+        Groups[groupId - 1].Process(loot, lootOwner, legacyRoll);
         return;
     }
 
     // Rolling non-grouped items
-    for (auto Entrie : Entries)
+    for (uint32 i = 0; i < Entries.size(); ++i)
     {
+        LootStoreItem const& entry = Entries[i];
+
         // Check condition
-        if (Entrie.conditionId && lootOwner && !PlayerOrGroupFulfilsCondition(loot, lootOwner, Entrie.conditionId))
+        if (entry.conditionId && lootOwner && !PlayerOrGroupFulfilsCondition(loot, lootOwner, entry.conditionId))
             continue;
 
-        if (!Entrie.Roll(rate))
+        if (!entry.Roll(rate))
             continue;                                       // Bad luck for the entry
 
-        if (Entrie.mincountOrRef < 0)                           // References processing
+        if (entry.mincountOrRef < 0)                        // References processing
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-Entrie.mincountOrRef);
+            LootTemplate const* referenced = References[i];
 
-            if (!Referenced)
+            if (!referenced)
                 continue;                                   // Error message already printed at loading stage
 
-            for (uint32 loop = 0; loop < Entrie.maxcount; ++loop) // Ref multiplicator
-                Referenced->Process(loot, lootOwner, store, rate, Entrie.group);
+            for (uint32 loop = 0; loop < entry.maxcount; ++loop) // Ref multiplicator
+                referenced->Process(loot, lootOwner, store, rate, entry.group, legacyRoll);
         }
         else                                                // Plain entries (not a reference, not grouped)
-            loot.AddItem(Entrie);                               // Chance is already checked, just add
+            loot.AddItem(entry);                            // Chance is already checked, just add
     }
 
     // Now processing groups
-    for (const auto& Group : Groups)
-        Group.Process(loot, lootOwner);
+    for (const auto& group : Groups)
+        group.Process(loot, lootOwner, legacyRoll);
 }
 
 // True if template includes at least 1 quest drop entry
@@ -2603,6 +2890,64 @@ void LootTemplate::Verify(LootStore const& lootstore, uint32 id) const
     // TODO: References validity checks
 }
 
+// Builds the precomputed roll tables of the groups (at loading stage)
+void LootTemplate::Compile()
+{
+    for (auto& group : Groups)
+        group.Compile();
+}
+
+// Resolves the referenced templates once instead of searching them at every loot generation
+// Must be called again each time LootTemplates_Reference is (re)loaded
+void LootTemplate::LinkReferences()
+{
+    References.assign(Entries.size(), nullptr);
+    for (uint32 i = 0; i < Entries.size(); ++i)
+        if (Entries[i].mincountOrRef < 0)
+            References[i] = LootTemplates_Reference.GetLootFor(-Entries[i].mincountOrRef);
+}
+
+// Must be called after references linking of all templates
+void LootTemplate::UpdateLooterIndependence()
+{
+    LooterIndependent = !DependsOnLooter();
+}
+
+// True if the template (including its references) contains conditional, quest or quest starting items
+// Referenced templates must be linked already
+bool LootTemplate::DependsOnLooter(uint8 groupId) const
+{
+    if (groupId)                                            // Group reference
+        return groupId <= Groups.size() && Groups[groupId - 1].DependsOnLooter();
+
+    for (uint32 i = 0; i < Entries.size(); ++i)
+    {
+        LootStoreItem const& entry = Entries[i];
+        if (entry.conditionId)
+            return true;
+
+        if (entry.mincountOrRef < 0)                        // References
+        {
+            if (References[i] && References[i]->DependsOnLooter(entry.group))
+                return true;
+            continue;
+        }
+
+        if (entry.needs_quest)
+            return true;
+
+        ItemPrototype const* proto = ObjectMgr::GetItemPrototype(entry.itemid);
+        if (!proto || proto->StartQuest)
+            return true;
+    }
+
+    for (const auto& group : Groups)
+        if (group.DependsOnLooter())
+            return true;
+
+    return false;
+}
+
 void LootTemplate::CheckLootRefs(LootIdSet* ref_set) const
 {
     for (auto Entrie : Entries)
@@ -2828,6 +3173,16 @@ void LoadLootTemplates_Reference()
 
     // output error for any still listed ids (not referenced from any loot table)
     LootTemplates_Reference.ReportUnusedIds(ids_set);
+
+    // referenced templates were (re)created, update the links kept by all stores
+    LootTemplates_Creature.LinkReferences();
+    LootTemplates_Fishing.LinkReferences();
+    LootTemplates_Gameobject.LinkReferences();
+    LootTemplates_Item.LinkReferences();
+    LootTemplates_Pickpocketing.LinkReferences();
+    LootTemplates_Skinning.LinkReferences();
+    LootTemplates_Disenchant.LinkReferences();
+    LootTemplates_Mail.LinkReferences();
 }
 
 // Vote for an ongoing roll
@@ -2851,6 +3206,13 @@ void LootMgr::PlayerVote(Player* player, ObjectGuid const& lootTargetGuid, uint3
     roll->PlayerVote(player, vote);
 }
 
+void LootMgr::GenerateMetrics()
+{
+    metric::measurement meas("world.metrics.loot");
+    meas.add_field("deferred", std::to_string(m_deferredLootCount.exchange(0)));
+    meas.add_field("avoided", std::to_string(m_avoidedLootCount.exchange(0)));
+}
+
 // Get loot by object guid
 // If target guid is not provided, try to find it by recipient or current player target
 Loot* LootMgr::GetLoot(Player* player, ObjectGuid const& targetGuid) const
@@ -2986,4 +3348,45 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
         chat.PSendSysMessage(LANG_ITEM_LIST_CHAT, itemId, itemId, name.c_str(), ss.str().c_str());
         sLog.outString("%6u - %-45s \tfound %6u/%-6u \tso %8s%% drop", itemStat.first, name.c_str(), itemStat.second, amountOfCheck, ss.str().c_str());
     }
+
+    // same amount of drops with the legacy (uncompiled) group rolls, both samples must come from the same distribution
+    std::unordered_map<uint32, uint32> legacyStatsMap;
+    for (uint32 i = 1; i <= amountOfCheck; ++i)
+    {
+        lootTable->Process(*loot, nullptr, *store, store->IsRatesAllowed(), 0, true);
+        for (auto lootItem : loot->m_lootItems)
+            ++legacyStatsMap[lootItem->itemId];
+        loot->Clear();
+    }
+
+    // Pearson chi-squared test of homogeneity on the per item drop counts (2 x k contingency table, equal sample sizes)
+    double chiSquared = 0.0;
+    uint32 degreesOfFreedom = 0;
+    for (auto const& legacyStat : legacyStatsMap)
+        itemStatsMap.emplace(legacyStat.first, 0);
+    for (auto const& itemStat : itemStatsMap)
+    {
+        double compiledCount = itemStat.second;
+        auto legacyItr = legacyStatsMap.find(itemStat.first);
+        double legacyCount = legacyItr != legacyStatsMap.end() ? legacyItr->second : 0;
+        double expected = (compiledCount + legacyCount) / 2;
+        if (expected <= 0.0)
+            continue;
+
+        chiSquared += (compiledCount - expected) * (compiledCount - expected) / expected;
+        chiSquared += (legacyCount - expected) * (legacyCount - expected) / expected;
+        ++degreesOfFreedom;
+    }
+
+    if (degreesOfFreedom > 1)
+    {
+        --degreesOfFreedom;
+        // Wilson-Hilferty approximation of the 99.9% quantile of the chi-squared distribution
+        double const z = 3.0902;
+        double const k = degreesOfFreedom;
+        double const critical = k * std::pow(1.0 - 2.0 / (9.0 * k) + z * std::sqrt(2.0 / (9.0 * k)), 3);
+        char const* verdict = chiSquared <= critical ? "same distribution" : "DISTRIBUTION MISMATCH";
+        chat.PSendSysMessage("Compiled vs legacy rolls: chi2 = %.2f, df = %u, critical(99.9%%) = %.2f -> %s", chiSquared, degreesOfFreedom, critical, verdict);
+        sLog.outString("Compiled vs legacy rolls: chi2 = %.2f, df = %u, critical(99.9%%) = %.2f -> %s", chiSquared, degreesOfFreedom, critical, verdict);
+    }
 }
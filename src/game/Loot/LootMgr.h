@@ -24,6 +24,7 @@
 #include "Globals/SharedDefines.h"
 
 #include <vector>
+#include <atomic>
 #include "Entities/Bag.h"
 
 #define LOOT_ROLL_TIMEOUT  (1*MINUTE*IN_MILLISECONDS)
@@ -210,8 +211,13 @@ struct LootItem
 
     // Basic checks for player/item compatibility - if false no chance to see the item in the loot
     bool AllowedForPlayer(Player const* player, WorldObject const* lootTarget) const;
+    bool IsAllowedForAnyPlayer() const;
     LootSlotType GetSlotTypeForSharedLoot(Player const* player, Loot const* loot) const;
     bool IsAllowed(Player const* player, Loot const* loot) const;
+
+    // LootItem blocks are recycled through a per thread free list (see LootMgr.cpp)
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
 };
 
 typedef std::vector<LootItem*> LootItemList;
@@ -232,6 +238,7 @@ class LootStore
         void CheckLootRefs(LootIdSet* ref_set = nullptr) const; // check existence reference and remove it from ref_set
         void ReportUnusedIds(LootIdSet const& ids_set) const;
         void ReportNotExistedId(uint32 id) const;
+        void LinkReferences();                              // resolve reference entries to templates of LootTemplates_Reference
 
         bool HaveLootFor(uint32 loot_id) const { return m_LootTemplates.find(loot_id) != m_LootTemplates.end(); }
         bool HaveQuestLootFor(uint32 loot_id) const;
@@ -261,7 +268,8 @@ class LootTemplate
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem& item);
         // Rolls for every item in the template and adds the rolled items the the loot
-        void Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId = 0) const;
+        // legacyRoll forces the uncompiled group rolls (used to cross check the compiled tables)
+        void Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId = 0, bool legacyRoll = false) const;
 
         // True if template includes at least 1 quest drop entry
         bool HasQuestDrop(LootTemplateMap const& store, uint8 groupId = 0) const;
@@ -273,9 +281,19 @@ class LootTemplate
         // Checks integrity of the template
         void Verify(LootStore const& lootstore, uint32 id) const;
         void CheckLootRefs(LootIdSet* ref_set) const;
+        // Builds the precomputed roll tables of the groups (at loading stage)
+        void Compile();
+        void LinkReferences();
+        // True if the rolled items and their looting rights can't depend on the looters state (conditions, quests)
+        bool IsLooterIndependent() const { return LooterIndependent; }
+        void UpdateLooterIndependence();
     private:
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimized) processing, grouped entries go there
+        std::vector<LootTemplate const*> References;        // resolved referenced templates, parallel to Entries (nullptr for plain entries)
+        bool LooterIndependent = false;
+
+        bool DependsOnLooter(uint8 groupId = 0) const;
 };
 
 //=====================================================
@@ -312,7 +330,8 @@ class Loot
         void SetGoldAmount(uint32 _gold);
         void SendGold(Player* player);
         bool IsItemAlreadyIn(uint32 itemId) const;
-        void PrintLootList(ChatHandler& chat, WorldSession* session) const;
+        bool IsAnyItemAlreadyIn(std::vector<uint32> const& sortedItemIds) const;
+        void PrintLootList(ChatHandler& chat, WorldSession* session);
         bool HasLoot() const;
         uint32 GetGoldAmount() const { return m_gold; }
         LootType GetLootType() const { return m_lootType; }
@@ -329,7 +348,8 @@ class Loot
     private:
         Loot(): m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(),
             m_clientLootType(), m_lootMethod(), m_threshold(), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false)
+            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false),
+            m_deferredStore(nullptr), m_deferredLootId(0), m_deferredSeed(0), m_deferredMasterLooterFound(false)
         {}
         void Clear();
         bool IsLootedFor(Player const* player) const;
@@ -345,6 +365,9 @@ class Loot
         void SetGroupLootRight(Player* player);
         void GenerateMoneyLoot(uint32 minAmount, uint32 maxAmount);
         bool FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, bool personal, bool noEmptyError = false);
+        void SetItemsLootRight(bool masterLooterFound, bool deferred);
+        bool DeferItemsGeneration(uint32 loot_id, LootStore const& store, Player* lootOwner);
+        void GenerateDeferredItems();
         void ForceLootAnimationClientUpdate() const;
         void SetPlayerIsLooting(Player* player);
         void SetPlayerIsNotLooting(Player* player);
@@ -377,6 +400,13 @@ class Loot
         GuidSet          m_playersLooting;                // player who opened loot windows
         GuidSet          m_playersOpened;                 // players that have released the corpse
         TimePoint        m_createTime;                    // create time (used to refill loot if need)
+
+        // Deferred items generation (Loot.DeferredGeneration), items are generated at first access
+        LootStore const* m_deferredStore;                 // store of the not yet generated items (nullptr if none)
+        uint32           m_deferredLootId;                // loot template id of the not yet generated items
+        uint32           m_deferredSeed;                  // seed of the random generator used to generate the items
+        bool             m_deferredMasterLooterFound;     // master looter was present at loot creation
+        GuidSet          m_deferredOwnerSet;              // owners present at loot creation, the only ones to get rights on the items
 };
 
 extern LootStore LootTemplates_Creature;
@@ -419,6 +449,15 @@ class LootMgr
         void PlayerVote(Player* player, ObjectGuid const& lootTargetGuid, uint32 itemSlot, RollVote vote);
         Loot* GetLoot(Player* player, ObjectGuid const& targetGuid = ObjectGuid()) const;
         void CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore) const;
+
+        // Deferred items generation statistics (thread safe due to atomics)
+        void IncrementDeferredLootCounter() { ++m_deferredLootCount; }
+        void IncrementAvoidedLootCounter() { ++m_avoidedLootCount; }
+        void GenerateMetrics();
+
+    private:
+        std::atomic<uint32> m_deferredLootCount = { 0 };   // loots created with deferred items
+        std::atomic<uint32> m_avoidedLootCount = { 0 };    // deferred loots destroyed without its items ever generated
 };
 
 #define sLootMgr MaNGOS::Singleton<LootMgr>::Instance()
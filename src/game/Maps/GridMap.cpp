@@ -690,7 +690,7 @@ bool GridMap::ExistVMap(uint32 mapid, int gx, int gy)
 }
 
 //////////////////////////////////////////////////////////////////////////
-TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
+TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid), m_cleanUpCursor(0)
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
     {
@@ -759,30 +759,40 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+    // release at most GridUnload.TilesPerUpdate tiles, the pass is continued at next update from where it stopped
+    uint32 const maxReleased = sWorld.getConfig(CONFIG_UINT32_GRID_UNLOAD_TILES_PER_UPDATE);
+    uint32 released = 0;
+
+    for (; m_cleanUpCursor < MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS; ++m_cleanUpCursor)
     {
-        for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        const int x = m_cleanUpCursor % MAX_NUMBER_OF_GRIDS;
+        const int y = m_cleanUpCursor / MAX_NUMBER_OF_GRIDS;
+
+        const int16& iRef = m_GridRef[x][y];
+        GridMap* pMap = m_GridMaps[x][y];
+
+        // delete those GridMap objects which have refcount = 0
+        if (pMap && iRef == 0)
         {
-            const int16& iRef = m_GridRef[x][y];
-            GridMap* pMap = m_GridMaps[x][y];
+            if (maxReleased && released >= maxReleased)
+                return;                                     // timer is kept passed
 
-            // delete those GridMap objects which have refcount = 0
-            if (pMap && iRef == 0)
-            {
-                m_GridMaps[x][y] = nullptr;
-                // delete grid data if reference count == 0
-                pMap->unloadData();
-                delete pMap;
+            m_GridMaps[x][y] = nullptr;
+            // delete grid data if reference count == 0
+            pMap->unloadData();
+            delete pMap;
 
-                // unload VMAPS...
-                VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId, x, y);
+            // unload VMAPS...
+            VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId, x, y);
 
-                // unload mmap...
-                MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
-            }
+            // unload mmap...
+            MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
+
+            ++released;
         }
     }
 
+    m_cleanUpCursor = 0;
     i_timer.Reset();
 }
 
@@ -192,6 +192,7 @@ class TerrainInfo : public Referencable<std::atomic_long>
 
         // global garbage collection timer
         ShortIntervalTimer i_timer;
+        uint32 m_cleanUpCursor;                             // next tile checked by the garbage collection pass in progress
 
         typedef std::mutex LOCK_TYPE;
         typedef std::lock_guard<LOCK_TYPE> LOCK_GUARD;
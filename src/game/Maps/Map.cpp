@@ -594,6 +594,11 @@ void Map::Update(const uint32& t_diff)
 
     GetMessager().Execute(this);
 
+    if (uint32 maxSpawns = sWorld.getConfig(CONFIG_UINT32_GAME_EVENT_SPAWNS_PER_UPDATE))
+        m_spawnMessager.Execute(this, maxSpawns);
+    else
+        m_spawnMessager.Execute(this);
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -703,6 +708,13 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    ///- Write the respawn times buffered since the last save
+    m_persistentState->Update(t_diff);
+
+    ///- Destroy some of the objects left by previous grid unloads
+    if (!i_unloadedObjects.empty())
+        DeleteUnloadedObjects(false);
+
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
         ScriptsProcess();
@@ -965,6 +977,26 @@ void Map::UnloadAll(bool pForce)
         ++i;
         UnloadGrid(grid.getX(), grid.getY(), pForce);       // deletes the grid and removes it from the GridRefManager
     }
+
+    DeleteUnloadedObjects(true);
+}
+
+// Objects of unloaded grids are only detached from the map at unload (see ObjectGridUnloader), their destruction
+// is spread over the next updates (at most GridUnload.DeletePerUpdate objects per update) to avoid update spikes
+void Map::DeleteUnloadedObjects(bool all)
+{
+    size_t count = i_unloadedObjects.size();
+    if (!all)
+    {
+        if (uint32 maxDeleted = sWorld.getConfig(CONFIG_UINT32_GRID_UNLOAD_DELETE_PER_UPDATE))
+            count = std::min(count, size_t(maxDeleted));
+    }
+
+    // oldest first, the remaining ones are moved to the front
+    for (size_t i = 0; i < count; ++i)
+        delete i_unloadedObjects[i];
+
+    i_unloadedObjects.erase(i_unloadedObjects.begin(), i_unloadedObjects.begin() + count);
 }
 
 const char* Map::GetMapName() const
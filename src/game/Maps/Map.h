@@ -178,6 +178,7 @@ class Map : public GridRefManager<NGridType>
         // can return INVALID_HEIGHT if under z+2 z coord not found height
 
         virtual void RemoveAllObjectsInRemoveList();
+        void DeleteUnloadedObjects(bool all);
 
         bool CreatureRespawnRelocation(Creature* c);        // used only in CreatureRelocation and ObjectGridUnloader
 
@@ -197,6 +198,7 @@ class Map : public GridRefManager<NGridType>
         MapPersistentState* GetPersistentState() const { return m_persistentState; }
 
         void AddObjectToRemoveList(WorldObject* obj);
+        void AddUnloadedObject(WorldObject* obj) { i_unloadedObjects.push_back(obj); }
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, const CellPair& cellpair);
 
@@ -323,6 +325,7 @@ class Map : public GridRefManager<NGridType>
         uint32 GetLoadedGridsCount();
 
         Messager<Map>& GetMessager() { return m_messager; }
+        Messager<Map>& GetSpawnMessager() { return m_spawnMessager; } // executed within GameEvent.SpawnsPerUpdate
 
     private:
         void LoadMapAndVMap(int gx, int gy);
@@ -381,6 +384,7 @@ class Map : public GridRefManager<NGridType>
         WorldObjectSet::iterator m_onEventNotifiedIter;
 
         Messager<Map> m_messager;
+        Messager<Map> m_spawnMessager;
     private:
         time_t i_gridExpiry;
 
@@ -393,6 +397,7 @@ class Map : public GridRefManager<NGridType>
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
         WorldObjectSet i_objectsToRemove;
+        std::vector<WorldObject*> i_unloadedObjects;       // objects of unloaded grids, out of world and waiting for their deletion
 
         typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
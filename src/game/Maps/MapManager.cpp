@@ -27,14 +27,18 @@
 #include "Grids/CellImpl.h"
 #include "Globals/ObjectMgr.h"
 #include "Maps/MapWorkers.h"
+#include "Metric/Metric.h"
 #include <future>
 
+// pre-initialized map not taken in this time is rebuilt, must stay below NORMAL_INSTANCE_RESET_TIME
+#define PREWARMED_MAP_MAX_AGE (10 * MINUTE)
+
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
 
 MapManager::MapManager()
-    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN))
+    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)), m_prewarmHits(0), m_prewarmMisses(0)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
@@ -44,6 +48,10 @@ MapManager::~MapManager()
     for (auto& i_map : i_maps)
         delete i_map.second;
 
+    for (auto& prewarmed : m_prewarmedMaps)
+        for (auto& entry : prewarmed.second)
+            delete entry.map;
+
     for (auto m_Transport : m_Transports)
         delete m_Transport;
 
@@ -210,6 +218,8 @@ void MapManager::Update(uint32 diff)
     for (Transport* m_Transport : m_Transports)
         m_Transport->Update((uint32)i_timer.GetCurrent());
 
+    UpdatePrewarmedMaps();
+
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
     while (iter != i_maps.end())
@@ -255,6 +265,11 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    for (auto& prewarmed : m_prewarmedMaps)
+        for (auto& entry : prewarmed.second)
+            DeletePrewarmedMap(entry.map);
+    m_prewarmedMaps.clear();
+
     for (auto& i_map : i_maps)
         i_map.second->UnloadAll(true);
 
@@ -335,6 +350,12 @@ Map* MapManager::CreateInstance(uint32 id, Player* player)
         if (!map)
             pNewMap = CreateDungeonMap(id, NewInstanceId, pSave);
     }
+    else if (DungeonMap* prewarmed = TakePrewarmedMap(id))
+    {
+        // new instance, already built by UpdatePrewarmedMaps
+        NewInstanceId = prewarmed->GetInstanceId();
+        pNewMap = prewarmed;
+    }
     else
     {
         // if no instanceId via group members or instance saves is found
@@ -380,6 +401,104 @@ DungeonMap* MapManager::CreateDungeonMap(uint32 id, uint32 InstanceId, DungeonPe
     return map;
 }
 
+DungeonMap* MapManager::TakePrewarmedMap(uint32 id)
+{
+    if (sWorld.GetPrewarmMapIds().find(id) == sWorld.GetPrewarmMapIds().end())
+        return nullptr;
+
+    PrewarmedMapsMap::iterator itr = m_prewarmedMaps.find(id);
+    if (itr == m_prewarmedMaps.end() || itr->second.empty())
+    {
+        ++m_prewarmMisses;
+        return nullptr;
+    }
+
+    DungeonMap* map = itr->second.front().map;
+    itr->second.pop_front();
+
+    // raid reset passed while the map was waiting
+    time_t resetTime = map->GetPersistanceState()->GetResetTime();
+    if (resetTime && resetTime <= time(nullptr))
+    {
+        DeletePrewarmedMap(map);
+        ++m_prewarmMisses;
+        return nullptr;
+    }
+
+    ++m_prewarmHits;
+    return map;
+}
+
+void MapManager::UpdatePrewarmedMaps()
+{
+    Guard _guard(*this);
+
+    std::set<uint32> const& mapIds = sWorld.GetPrewarmMapIds();
+    uint32 count = sWorld.getConfig(CONFIG_UINT32_INSTANCE_PREWARM_COUNT);
+    time_t now = time(nullptr);
+
+    // drop pools of maps removed from config (at reload) and too old maps
+    for (PrewarmedMapsMap::iterator itr = m_prewarmedMaps.begin(); itr != m_prewarmedMaps.end();)
+    {
+        bool keep = mapIds.find(itr->first) != mapIds.end();
+        PrewarmedMapList& list = itr->second;
+        while (!list.empty() && (!keep || list.size() > count || list.front().createTime + PREWARMED_MAP_MAX_AGE < now))
+        {
+            DeletePrewarmedMap(list.front().map);
+            list.pop_front();
+        }
+
+        if (list.empty())
+            m_prewarmedMaps.erase(itr++);
+        else
+            ++itr;
+    }
+
+    // build at most one map per update to keep the cost out of any single tick
+    for (uint32 id : mapIds)
+    {
+        MapEntry const* entry = sMapStore.LookupEntry(id);
+        if (!entry || !entry->IsDungeon() || !ObjectMgr::GetInstanceTemplate(id))
+            continue;
+
+        PrewarmedMapList& list = m_prewarmedMaps[id];
+        if (list.size() >= count)
+            continue;
+
+        PrewarmedMap prewarmed;
+        prewarmed.map = CreateDungeonMap(id, GenerateInstanceId());
+        prewarmed.createTime = now;
+        list.push_back(prewarmed);
+        break;
+    }
+}
+
+void MapManager::DeletePrewarmedMap(DungeonMap* map)
+{
+    uint32 instanceId = map->GetInstanceId();
+
+    map->UnloadAll(true);
+    delete map;
+
+    // no player ever entered, so nothing can be bound to it
+    MapPersistentStateManager::DeleteInstanceFromDB(instanceId);
+}
+
+void MapManager::GenerateMetrics()
+{
+    uint32 pooled = 0;
+    {
+        Guard _guard(*this);
+        for (auto& prewarmed : m_prewarmedMaps)
+            pooled += prewarmed.second.size();
+    }
+
+    metric::measurement meas("world.metrics.map_pool");
+    meas.add_field("hits", std::to_string(m_prewarmHits.exchange(0)));
+    meas.add_field("misses", std::to_string(m_prewarmMisses.exchange(0)));
+    meas.add_field("pooled", std::to_string(pooled));
+}
+
 BattleGroundMap* MapManager::CreateBattleGroundMap(uint32 id, uint32 InstanceId, BattleGround* bg)
 {
     DEBUG_LOG("MapInstanced::CreateBattleGroundMap: instance:%d for map:%d and bgType:%d created.", InstanceId, id, bg->GetTypeId());
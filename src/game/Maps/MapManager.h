@@ -27,6 +27,9 @@
 #include "Grids/GridStates.h"
 #include "Maps/MapUpdater.h"
 
+#include <atomic>
+#include <deque>
+
 class Transport;
 class BattleGround;
 
@@ -146,6 +149,7 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        void GenerateMetrics();
 
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
@@ -176,6 +180,19 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         DungeonMap* CreateDungeonMap(uint32 id, uint32 InstanceId, DungeonPersistentState* save = nullptr);
         BattleGroundMap* CreateBattleGroundMap(uint32 id, uint32 InstanceId, BattleGround* bg);
 
+        // pool of empty initialized dungeon maps for Instance.Prewarm.Maps
+        struct PrewarmedMap
+        {
+            DungeonMap* map;
+            time_t createTime;
+        };
+        typedef std::deque<PrewarmedMap> PrewarmedMapList;
+        typedef std::map<uint32, PrewarmedMapList> PrewarmedMapsMap;
+
+        DungeonMap* TakePrewarmedMap(uint32 id);
+        void UpdatePrewarmedMaps();
+        static void DeletePrewarmedMap(DungeonMap* map);
+
         std::mutex m_lock;
         uint32 i_gridCleanUpDelay;
         MapMapType i_maps;
@@ -183,6 +200,10 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         uint32 i_MaxInstanceId;
         MapUpdater m_updater;
+
+        PrewarmedMapsMap m_prewarmedMaps;
+        std::atomic<uint32> m_prewarmHits;
+        std::atomic<uint32> m_prewarmMisses;
 };
 
 template<typename Do>
@@ -32,9 +32,11 @@
 #include "Groups/Group.h"
 #include "Maps/InstanceData.h"
 #include "ProgressBar.h"
+#include "Metric/Metric.h"
 
 #include <list>
 #include <cstdarg>
+#include <sstream>
 
 INSTANTIATE_SINGLETON_1(MapPersistentStateManager);
 
@@ -48,6 +50,7 @@ MapPersistentState::MapPersistentState(uint16 MapId, uint32 InstanceId)
     : m_instanceid(InstanceId), m_mapid(MapId),
       m_usedByMap(nullptr)
 {
+    m_respawnTimesSaveTimer.SetInterval(sWorld.getConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_INTERVAL));
 }
 
 MapPersistentState::~MapPersistentState()
@@ -70,54 +73,141 @@ bool MapPersistentState::UnloadIfEmpty()
     return true;
 }
 
+// Respawn times are buffered and written by SaveRespawnTimesToDB, at most SaveRespawnTime.BatchInterval later
 void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 {
-    SetCreatureRespawnTime(loguid, t);
+    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
+    if (!GetMapEntry()->IsBattleGround())
+        QueueRespawnTimeSave(m_pendingCreatureRespawnTimes, loguid, t);
+
+    SetCreatureRespawnTime(loguid, t);                      // state can be deleted at call if respawn time expired
+}
 
+void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+{
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGround())
+    if (!GetMapEntry()->IsBattleGround())
+        QueueRespawnTimeSave(m_pendingGORespawnTimes, loguid, t);
+
+    SetGORespawnTime(loguid, t);                            // state can be deleted at call if respawn time expired
+}
+
+void MapPersistentState::QueueRespawnTimeSave(RespawnTimes& pending, uint32 loguid, time_t t)
+{
+    pending[loguid] = t;
+    sMapPersistentStateMgr.AddRespawnTimeUnbatchedStatements(t > sWorld.GetGameTime() ? 2 : 1);
+
+    // without map (and so without updates) or without batching the respawn time is written at once
+    if (!m_usedByMap || !sWorld.getConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_INTERVAL) ||
+            m_pendingCreatureRespawnTimes.size() + m_pendingGORespawnTimes.size() >= sWorld.getConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_SIZE))
+        SaveRespawnTimesToDB();
+}
+
+// Called from the map update of the map using the state
+void MapPersistentState::Update(uint32 diff)
+{
+    m_respawnTimesSaveTimer.Update(diff);
+    if (!m_respawnTimesSaveTimer.Passed())
         return;
 
-    CharacterDatabase.BeginTransaction();
+    m_respawnTimesSaveTimer.SetInterval(sWorld.getConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_INTERVAL));
+    m_respawnTimesSaveTimer.SetCurrent(0);
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+    SaveRespawnTimesToDB();
+}
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM creature_respawn WHERE guid = ? AND instance = ?");
-    stmt.PExecute(loguid, m_instanceid);
+// Write respawn times of a table as one multi-row delete and insert (per MAX_RESPAWN_TIMES_PER_STATEMENT rows)
+static uint32 WriteRespawnTimes(char const* table, uint32 instanceId, MapPersistentState::RespawnTimes const& respawnTimes)
+{
+    uint32 const MAX_RESPAWN_TIMES_PER_STATEMENT = 500;
 
-    if (t > sWorld.GetGameTime())
+    time_t now = sWorld.GetGameTime();
+    uint32 statements = 0;
+
+    std::vector<std::pair<uint32, time_t> > toInsert;
+    toInsert.reserve(respawnTimes.size());
+
+    std::ostringstream ss;
+    uint32 rows = 0;
+    for (auto const& respawnTime : respawnTimes)
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO creature_respawn VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
+        if (respawnTime.second > now)
+            toInsert.push_back(respawnTime);
+
+        if (rows)
+            ss << ",";
+        else
+            ss << "DELETE FROM " << table << " WHERE instance = " << instanceId << " AND guid IN (";
+        ss << respawnTime.first;
+
+        if (++rows == MAX_RESPAWN_TIMES_PER_STATEMENT)
+        {
+            ss << ")";
+            CharacterDatabase.Execute(ss.str().c_str());
+            ++statements;
+            ss.str("");
+            rows = 0;
+        }
     }
 
-    CharacterDatabase.CommitTransaction();
+    if (rows)
+    {
+        ss << ")";
+        CharacterDatabase.Execute(ss.str().c_str());
+        ++statements;
+        ss.str("");
+        rows = 0;
+    }
+
+    // inserts after all deletes, rows of a guid can't be in two statements
+    for (auto const& respawnTime : toInsert)
+    {
+        if (rows)
+            ss << ",";
+        else
+            ss << "INSERT INTO " << table << " VALUES ";
+        ss << "(" << respawnTime.first << "," << uint64(respawnTime.second) << "," << instanceId << ")";
+
+        if (++rows == MAX_RESPAWN_TIMES_PER_STATEMENT)
+        {
+            CharacterDatabase.Execute(ss.str().c_str());
+            ++statements;
+            ss.str("");
+            rows = 0;
+        }
+    }
+
+    if (rows)
+    {
+        CharacterDatabase.Execute(ss.str().c_str());
+        ++statements;
+    }
+
+    return statements;
 }
 
-void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+void MapPersistentState::SaveRespawnTimesToDB()
 {
-    SetGORespawnTime(loguid, t);
-
-    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGround())
+    if (m_pendingCreatureRespawnTimes.empty() && m_pendingGORespawnTimes.empty())
         return;
 
-    CharacterDatabase.BeginTransaction();
+    bool const ownTransaction = !CharacterDatabase.IsInTransaction();
+    if (ownTransaction)
+        CharacterDatabase.BeginTransaction();
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+    uint32 statements = 0;
+    if (!m_pendingCreatureRespawnTimes.empty())
+        statements += WriteRespawnTimes("creature_respawn", m_instanceid, m_pendingCreatureRespawnTimes);
+    if (!m_pendingGORespawnTimes.empty())
+        statements += WriteRespawnTimes("gameobject_respawn", m_instanceid, m_pendingGORespawnTimes);
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM gameobject_respawn WHERE guid = ? AND instance = ?");
-    stmt.PExecute(loguid, m_instanceid);
+    if (ownTransaction)
+        CharacterDatabase.CommitTransaction();
 
-    if (t > sWorld.GetGameTime())
-    {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO gameobject_respawn VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
-    }
+    m_pendingCreatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();
 
-    CharacterDatabase.CommitTransaction();
+    sMapPersistentStateMgr.AddRespawnTimeStatements(statements);
 }
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
@@ -144,6 +234,8 @@ void MapPersistentState::SetGORespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::ClearRespawnTimes()
 {
+    m_pendingGORespawnTimes.clear();
+    m_pendingCreatureRespawnTimes.clear();
     m_goRespawnTimes.clear();
     m_creatureRespawnTimes.clear();
 
@@ -962,6 +1054,16 @@ void MapPersistentStateManager::_CleanupExpiredInstancesAtTime(time_t t)
 }
 
 
+void MapPersistentStateManager::GenerateMetrics()
+{
+    int64 unbatched = m_respawnTimeUnbatchedStatements.exchange(0);
+    int64 statements = m_respawnTimeStatements.exchange(0);
+
+    metric::measurement meas("world.metrics.respawn_save");
+    meas.add_field("statements", std::to_string(statements));
+    meas.add_field("saved_statements", std::to_string(std::max(unbatched - statements, int64(0))));
+}
+
 void MapPersistentStateManager::InitWorldMaps()
 {
     MapPersistentState* state = nullptr;                       // need any from created for shared pool state
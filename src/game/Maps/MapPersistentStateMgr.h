@@ -24,10 +24,12 @@
 #include "Database/DatabaseEnv.h"
 #include "Server/DBCStores.h"
 #include "Pools/PoolManager.h"
+#include "Timer.h"
 
 #include <list>
 #include <map>
 #include <mutex>
+#include <atomic>
 
 struct InstanceTemplate;
 struct MapEntry;
@@ -76,11 +78,16 @@ class MapPersistentState
         Map* GetMap() const { return m_usedByMap; }         // Can be nullptr if map not loaded for persistent state
         void SetUsedByMapState(Map* map)
         {
+            if (!map)
+                SaveRespawnTimesToDB();                     // no more updates to write them later
+
             m_usedByMap = map;
             if (!map)
                 UnloadIfEmpty();
         }
 
+        void Update(uint32 diff);
+
         time_t GetCreatureRespawnTime(uint32 loguid) const
         {
             RespawnTimes::const_iterator itr = m_creatureRespawnTimes.find(loguid);
@@ -93,6 +100,7 @@ class MapPersistentState
             return itr != m_goRespawnTimes.end() ? itr->second : 0;
         }
         void SaveGORespawnTime(uint32 loguid, time_t t);
+        void SaveRespawnTimesToDB();                        // write the respawn times buffered by SaveCreatureRespawnTime/SaveGORespawnTime
 
         // pool system
         void InitPools();
@@ -114,12 +122,15 @@ class MapPersistentState
         void ClearRespawnTimes();
         bool HasRespawnTimes() const { return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty(); }
 
+    public:
+        typedef std::unordered_map<uint32, time_t> RespawnTimes;
+
     private:
         void SetCreatureRespawnTime(uint32 loguid, time_t t);
         void SetGORespawnTime(uint32 loguid, time_t t);
+        void QueueRespawnTimeSave(RespawnTimes& pending, uint32 loguid, time_t t);
 
     private:
-        typedef std::unordered_map<uint32, time_t> RespawnTimes;
 
         uint32 m_instanceid;
         uint32 m_mapid;
@@ -128,6 +139,9 @@ class MapPersistentState
         // persistent data
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
+        RespawnTimes m_pendingCreatureRespawnTimes;         // respawn times not yet written to DB (expired ones are only deleted)
+        RespawnTimes m_pendingGORespawnTimes;               // respawn times not yet written to DB (expired ones are only deleted)
+        ShortIntervalTimer m_respawnTimesSaveTimer;
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
 
         SpawnedPoolData m_spawnedPoolData;                  // Pools spawns state for map copy
@@ -346,6 +360,11 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
         void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups);
 
         void Update() { m_Scheduler.Update(); }
+
+        // Batched respawn times save statistics (thread safe due to atomics)
+        void AddRespawnTimeUnbatchedStatements(uint32 count) { m_respawnTimeUnbatchedStatements += count; }
+        void AddRespawnTimeStatements(uint32 count) { m_respawnTimeStatements += count; }
+        void GenerateMetrics();
     private:
         typedef std::unordered_map < uint32 /*InstanceId or MapId*/, MapPersistentState* > PersistentStateMap;
 
@@ -365,6 +384,9 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
         PersistentStateMap m_instanceSaveByMapId;
 
         DungeonResetScheduler m_Scheduler;
+
+        std::atomic<int64> m_respawnTimeUnbatchedStatements = { 0 }; // statements the saved respawn times would have needed if written one by one
+        std::atomic<int64> m_respawnTimeStatements = { 0 };          // statements used to write them
 };
 
 template<typename Do>
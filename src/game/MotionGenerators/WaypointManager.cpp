@@ -26,6 +26,96 @@
 
 INSTANTIATE_SINGLETON_1(WaypointManager);
 
+void WaypointPath::clear()
+{
+    m_nodes.clear();
+    m_segments.clear();
+    m_consecutive = true;
+}
+
+size_t WaypointPath::FindIndex(uint32 pointId) const
+{
+    if (m_nodes.empty())
+        return 0;
+
+    if (m_consecutive)
+    {
+        // overflow puts pointIds before the first node out of range too
+        size_t index = size_t(pointId - m_nodes.front().first);
+        return index < m_nodes.size() ? index : m_nodes.size();
+    }
+
+    NodeList::const_iterator itr = std::lower_bound(m_nodes.begin(), m_nodes.end(), pointId,
+        [](WaypointPathEntry const& entry, uint32 id) { return entry.first < id; });
+    if (itr == m_nodes.end() || itr->first != pointId)
+        return m_nodes.size();
+
+    return size_t(itr - m_nodes.begin());
+}
+
+WaypointNode& WaypointPath::operator[](uint32 pointId)
+{
+    // nodes are mostly added in order, check the common append case first
+    if (m_nodes.empty() || m_nodes.back().first < pointId)
+    {
+        if (!m_nodes.empty() && m_nodes.back().first + 1 != pointId)
+            m_consecutive = false;
+
+        m_nodes.emplace_back(pointId, WaypointNode());
+        m_segments.emplace_back();
+        return m_nodes.back().second;
+    }
+
+    NodeList::iterator itr = std::lower_bound(m_nodes.begin(), m_nodes.end(), pointId,
+        [](WaypointPathEntry const& entry, uint32 id) { return entry.first < id; });
+    if (itr->first == pointId)
+        return itr->second;
+
+    m_consecutive = false;
+    m_segments.emplace(m_segments.begin() + (itr - m_nodes.begin()));
+    return m_nodes.emplace(itr, pointId, WaypointNode())->second;
+}
+
+size_t WaypointPath::erase(uint32 pointId)
+{
+    size_t index = FindIndex(pointId);
+    if (index >= m_nodes.size())
+        return 0;
+
+    m_nodes.erase(m_nodes.begin() + index);
+    m_segments.erase(m_segments.begin() + index);
+    m_consecutive = false;
+    return 1;
+}
+
+void WaypointPath::Freeze()
+{
+    m_nodes.shrink_to_fit();
+    m_segments.resize(m_nodes.size());
+    m_segments.shrink_to_fit();
+
+    m_consecutive = true;
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        WaypointNode const& node = m_nodes[i].second;
+        WaypointNode const& next = m_nodes[(i + 1) % m_nodes.size()].second;
+
+        WaypointSegment& segment = m_segments[i];
+        float dx = next.x - node.x;
+        float dy = next.y - node.y;
+        float dz = next.z - node.z;
+        segment.length = sqrt(dx * dx + dy * dy + dz * dz);
+        segment.flags = WAYPOINT_NODE_FLAG_NONE;
+        if (node.orientation != 100)
+            segment.flags |= WAYPOINT_NODE_FLAG_FACING;
+        if (node.script_id)
+            segment.flags |= WAYPOINT_NODE_FLAG_SCRIPT;
+
+        if (m_nodes[i].first != m_nodes.front().first + i)
+            m_consecutive = false;
+    }
+}
+
 char const* waypointOriginTables[] =
 {
     "",
@@ -85,7 +175,7 @@ void WaypointManager::Load()
         delete result;
 
         //                                   0   1      2           3           4           5            6         7
-        result = WorldDatabase.Query("SELECT id, point, position_x, position_y, position_z, orientation, waittime, script_id FROM creature_movement");
+        result = WorldDatabase.Query("SELECT id, point, position_x, position_y, position_z, orientation, waittime, script_id FROM creature_movement ORDER BY id, point");
 
         BarGoLink bar(result->GetRowCount());
 
@@ -169,6 +259,9 @@ void WaypointManager::Load()
         for (uint32 itr : blacklistWaypoints)
             m_pathMap.erase(itr);
 
+        for (auto& itr : m_pathMap)
+            itr.second.Freeze();
+
         if (!creatureNoMoveType.empty())
         {
             for (uint32 itr : creatureNoMoveType)
@@ -221,7 +314,7 @@ void WaypointManager::Load()
         delete result;
 
         //                                   0      1       2      3           4           5           6            7
-        result = WorldDatabase.Query("SELECT entry, pathId, point, position_x, position_y, position_z, orientation, waittime, script_id FROM creature_movement_template");
+        result = WorldDatabase.Query("SELECT entry, pathId, point, position_x, position_y, position_z, orientation, waittime, script_id FROM creature_movement_template ORDER BY entry, pathId, point");
 
         BarGoLink bar(result->GetRowCount());
         std::set<uint32> blacklistWaypoints;
@@ -293,6 +386,9 @@ void WaypointManager::Load()
         for (uint32 itr : blacklistWaypoints)
             m_pathTemplateMap.erase(itr);
 
+        for (auto& itr : m_pathTemplateMap)
+            itr.second.Freeze();
+
         sLog.outString(">> Loaded %u path templates with %u nodes and %u behaviors from waypoint templates", total_paths, total_nodes, total_behaviors);
         sLog.outString();
     }
@@ -320,7 +416,9 @@ bool WaypointManager::AddExternalNode(uint32 entry, int32 pathId, uint32 pointId
         return false;
     }
 
-    m_externalPathTemplateMap[(entry << 8) + pathId][pointId] = WaypointNode(x, y, z, o, waittime, scriptId);
+    WaypointPath& path = m_externalPathTemplateMap[(entry << 8) + pathId];
+    path[pointId] = WaypointNode(x, y, z, o, waittime, scriptId);
+    path.Freeze();
     return true;
 }
 
@@ -361,6 +459,7 @@ WaypointNode const* WaypointManager::AddNode(uint32 entry, uint32 dbGuid, uint32
 
     // Insert new or remaining
     path[nextPoint] = temp;
+    path.Freeze();
 
     uint32 key = wpDest == PATH_FROM_GUID ? dbGuid : entry;
 
@@ -403,6 +502,7 @@ void WaypointManager::DeleteNode(uint32 entry, uint32 dbGuid, uint32 point, uint
         WorldDatabase.PExecuteLog("DELETE FROM %s WHERE %s=%u AND point=%u", table, key_field, key, point);
 
     path->erase(point);
+    path->Freeze();
 }
 
 void WaypointManager::DeletePath(uint32 id)
@@ -441,6 +541,7 @@ void WaypointManager::SetNodePosition(uint32 entry, uint32 dbGuid, uint32 point,
         find->second.x = x;
         find->second.y = y;
         find->second.z = z;
+        path->Freeze();
     }
 }
 
@@ -487,7 +588,10 @@ void WaypointManager::SetNodeOrientation(uint32 entry, uint32 dbGuid, uint32 poi
 
     WaypointPath::iterator find = path->find(point);
     if (find != path->end())
+    {
         find->second.orientation = orientation;
+        path->Freeze();
+    }
 }
 
 /// return true if a valid scriptId is provided
@@ -511,7 +615,10 @@ bool WaypointManager::SetNodeScriptId(uint32 entry, uint32 dbGuid, uint32 point,
 
     WaypointPath::iterator find = path->find(point);
     if (find != path->end())
+    {
         find->second.script_id = scriptId;
+        path->Freeze();
+    }
 
     return sCreatureMovementScripts.second.find(scriptId) != sCreatureMovementScripts.second.end();
 }
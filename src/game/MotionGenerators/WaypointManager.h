@@ -42,7 +42,75 @@ struct WaypointNode
         : x(_x), y(_y), z(_z), orientation(_o), delay(_delay), script_id(_script_id) {}
 };
 
-typedef std::map<uint32 /*pointId*/, WaypointNode> WaypointPath;
+enum WaypointNodeFlags
+{
+    WAYPOINT_NODE_FLAG_NONE     = 0x00,
+    WAYPOINT_NODE_FLAG_FACING   = 0x01,                     // orientation != 100, face it on arrival
+    WAYPOINT_NODE_FLAG_SCRIPT   = 0x02,                     // script_id set, start movement script on arrival
+};
+
+// Precomputed data about the segment from a node to the next one (the last node links to the first)
+struct WaypointSegment
+{
+    float length;
+    uint32 flags;
+    WaypointSegment() : length(0.0f), flags(WAYPOINT_NODE_FLAG_NONE) {}
+};
+
+typedef std::pair<uint32 /*pointId*/, WaypointNode> WaypointPathEntry;
+
+/**
+ * Waypoint path stored as an array of nodes sorted by point id.
+ *
+ * Paths are filled once at load time and then frozen: segment lengths and node flags are
+ * precomputed and, for the usual case of consecutive point ids, a point id lookup is a single
+ * indexed fetch. The path object is shared by every creature walking it, so movement generators
+ * should keep node indexes rather than iterators, as GM edits may move the nodes around.
+ */
+class WaypointPath
+{
+    public:
+        typedef std::vector<WaypointPathEntry> NodeList;
+        typedef NodeList::iterator iterator;
+        typedef NodeList::const_iterator const_iterator;
+        typedef NodeList::reverse_iterator reverse_iterator;
+        typedef NodeList::const_reverse_iterator const_reverse_iterator;
+
+        WaypointPath() : m_consecutive(true) {}
+
+        iterator begin() { return m_nodes.begin(); }
+        iterator end() { return m_nodes.end(); }
+        const_iterator begin() const { return m_nodes.begin(); }
+        const_iterator end() const { return m_nodes.end(); }
+        reverse_iterator rbegin() { return m_nodes.rbegin(); }
+        reverse_iterator rend() { return m_nodes.rend(); }
+        const_reverse_iterator rbegin() const { return m_nodes.rbegin(); }
+        const_reverse_iterator rend() const { return m_nodes.rend(); }
+
+        size_t size() const { return m_nodes.size(); }
+        bool empty() const { return m_nodes.empty(); }
+        void clear();
+
+        WaypointPathEntry const& at(size_t index) const { return m_nodes[index]; }
+        WaypointSegment const& GetSegment(size_t index) const { return m_segments[index]; }
+
+        iterator find(uint32 pointId) { return m_nodes.begin() + FindIndex(pointId); }
+        const_iterator find(uint32 pointId) const { return m_nodes.begin() + FindIndex(pointId); }
+        /// Index of the node with this point id, size() if there is none
+        size_t FindIndex(uint32 pointId) const;
+
+        /// Access the node with this point id, inserting it at its sorted position if needed
+        WaypointNode& operator[](uint32 pointId);
+        size_t erase(uint32 pointId);
+
+        /// Recompute segment data and the lookup shortcut, must be called after the nodes have been modified
+        void Freeze();
+
+    private:
+        NodeList m_nodes;
+        std::vector<WaypointSegment> m_segments;
+        bool m_consecutive;                                 // point ids are m_nodes[0].first + index
+};
 
 class WaypointManager
 {
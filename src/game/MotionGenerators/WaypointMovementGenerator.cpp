@@ -62,7 +62,7 @@ void WaypointMovementGenerator<Creature>::LoadPath(Creature& creature, int32 pat
     // Initialize the i_currentNode to point to the first node
     i_currentNode = i_path->begin()->first;
     m_lastReachedWaypoint = 0;
-    m_currentWaypointNode = i_path->begin();
+    m_currentWaypointIndex = 0;
 
     if (i_path->size() < 2)
     {
@@ -101,26 +101,22 @@ void WaypointMovementGenerator<Creature>::InitializeWaypointPath(Creature& u, in
     uint32 startPoint = -1;                                 // TODO add an argument to set the start point
     if (startPoint >= 0)
     {
-        auto selPoint = i_path->find(startPoint);
-        if (selPoint != i_path->end())
+        size_t selIndex = i_path->FindIndex(startPoint);
+        if (selIndex < i_path->size())
         {
             i_currentNode = startPoint;
-            m_currentWaypointNode = selPoint;
+            m_currentWaypointIndex = selIndex;
         }
         else
         {
-            m_currentWaypointNode = i_path->begin();
-            i_currentNode = m_currentWaypointNode->first;
+            m_currentWaypointIndex = 0;
+            i_currentNode = GetCurrentEntry().first;
         }
     }
 
     // fixup last reached node
-    if (m_currentWaypointNode != i_path->begin())
-    {
-        auto lastNode = m_currentWaypointNode;
-        --lastNode;
-        m_lastReachedWaypoint = lastNode->first;
-    }
+    if (m_currentWaypointIndex != 0)
+        m_lastReachedWaypoint = i_path->at(m_currentWaypointIndex - 1).first;
     else
         m_lastReachedWaypoint = 0;
 
@@ -163,11 +159,11 @@ void WaypointMovementGenerator<Creature>::OnArrived(Creature& creature)
     if (m_lastReachedWaypoint == i_currentNode)
         return;
 
-    m_lastReachedWaypoint = m_currentWaypointNode->first;
+    m_lastReachedWaypoint = GetCurrentEntry().first;
 
-    WaypointNode const& node = m_currentWaypointNode->second;
+    WaypointNode const& node = GetCurrentEntry().second;
 
-    if (node.script_id)
+    if (i_path->GetSegment(m_currentWaypointIndex).flags & WAYPOINT_NODE_FLAG_SCRIPT)
     {
         DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "Creature movement start script %u at point %u for %s.", node.script_id, i_currentNode, creature.GetGuidStr().c_str());
         creature.GetMap()->ScriptsStart(sCreatureMovementScripts, node.script_id, &creature, &creature);
@@ -189,11 +185,9 @@ void WaypointMovementGenerator<Creature>::OnArrived(Creature& creature)
     int32 newWaitTime = node.delay + m_scriptTime;
 
     // switch to next node
-    ++m_currentWaypointNode;
-    if (m_currentWaypointNode == i_path->end())
-    {
-        m_currentWaypointNode = i_path->begin();
-    }
+    ++m_currentWaypointIndex;
+    if (m_currentWaypointIndex == i_path->size())
+        m_currentWaypointIndex = 0;
 
     // Wait delay ms
     if (newWaitTime > 0)
@@ -219,17 +213,17 @@ void WaypointMovementGenerator<Creature>::OnArrived(Creature& creature)
     {
         // Inform AI that we start to move
         if (creature.AI() && m_PathOrigin == PATH_FROM_EXTERNAL)
-            InformAI(creature, uint32(EXTERNAL_WAYPOINT_MOVE_START), m_currentWaypointNode->first);
+            InformAI(creature, uint32(EXTERNAL_WAYPOINT_MOVE_START), GetCurrentEntry().first);
     }
 
-    i_currentNode = m_currentWaypointNode->first;
+    i_currentNode = GetCurrentEntry().first;
     m_scriptTime = 0;
 }
 
 // a way to build path from two near points in LOS without using mmap, this may need to be moved in map
 // start position should be the last element of path container
 // return added travel time
-uint32 WaypointMovementGenerator<Creature>::BuildIntPath(PointsArray& path, Creature& creature, Vector3 const& endPos) const
+uint32 WaypointMovementGenerator<Creature>::BuildIntPath(PointsArray& path, Creature& creature, Vector3 const& endPos, float knownDistance/* = -1.0f*/) const
 {
     static const float  MinimumDistance = 4;                // minimum distance to work with in yard (shortcut if under this)
     static const float  TerrainStep     = 2.5;              // min step between each int point in yard
@@ -245,7 +239,7 @@ uint32 WaypointMovementGenerator<Creature>::BuildIntPath(PointsArray& path, Crea
     bool onTheGround = !creature.IsFlying() && !creature.IsSwimming();
     // cache offset for direction
     const Vector3 offset = endPos - startPos;
-    const float distance = offset.magnitude();
+    const float distance = knownDistance >= 0.0f ? knownDistance : offset.magnitude();
     if (distance >= MinimumDistance)
     {
         // compute direction to end position
@@ -398,7 +392,9 @@ void WaypointMovementGenerator<Creature>::SendNextWayPointPath(Creature& creatur
 
     creature.addUnitState(UNIT_STAT_ROAMING_MOVE);
 
-    WaypointNode const* nextNode = &m_currentWaypointNode->second;
+    ClampCurrentIndex();
+    WaypointNode const* nextNode = &GetCurrentEntry().second;
+    size_t nextIndex = m_currentWaypointIndex;
 
     // Inform AI that we start to move or reached last node
     if (creature.AI() && m_PathOrigin == PATH_FROM_EXTERNAL)
@@ -426,30 +422,29 @@ void WaypointMovementGenerator<Creature>::SendNextWayPointPath(Creature& creatur
     // compute path to next node and put it in the path
     uint32 travelTime = BuildIntPath(genPath, creature, Vector3(nextNode->x, nextNode->y, nextNode->z));
 
-    auto currPointItr = m_currentWaypointNode;
     // add more node until travel time is big enough
     while (!nextNode->delay && travelTime < MinimumPathTime)
     {
         // we'll add path to node after this one too to make animation more smoother
-        auto nodeAfterItr = currPointItr;
-        ++nodeAfterItr;
-        if (nodeAfterItr == i_path->end())
-            nodeAfterItr = i_path->begin();
+        size_t nodeAfterIndex = nextIndex + 1;
+        if (nodeAfterIndex == i_path->size())
+            nodeAfterIndex = 0;
 
-        if (nodeAfterItr == m_currentWaypointNode)
+        if (nodeAfterIndex == m_currentWaypointIndex)
         {
             // did all the path and not reached MinimumPathTime?
             break;
         }
 
-        auto const nodeAfter = nodeAfterItr->second;
+        WaypointNode const& nodeAfter = i_path->at(nodeAfterIndex).second;
 
         // extend path only if next node is different than current node
         m_nodeIndexes.push_back(genPath.size() - 1);
         Vector3 nodeAfterCoord(nodeAfter.x, nodeAfter.y, nodeAfter.z);
-        travelTime += BuildIntPath(genPath, creature, nodeAfterCoord);
-        currPointItr = nodeAfterItr;
-        nextNode = &nodeAfterItr->second;
+        // the path ends on the previous node so the segment length is already known
+        travelTime += BuildIntPath(genPath, creature, nodeAfterCoord, i_path->GetSegment(nextIndex).length);
+        nextIndex = nodeAfterIndex;
+        nextNode = &nodeAfter;
     }
 
     // show path in the client if need
@@ -481,7 +476,7 @@ void WaypointMovementGenerator<Creature>::SendNextWayPointPath(Creature& creatur
 
     Movement::MoveSplineInit init(creature);
     init.MovebyPath(genPath);
-    if (nextNode->orientation != 100 && nextNode->delay != 0)
+    if ((i_path->GetSegment(nextIndex).flags & WAYPOINT_NODE_FLAG_FACING) && nextNode->delay != 0)
         init.SetFacing(nextNode->orientation);
     creature.SetWalk(!creature.hasUnitState(UNIT_STAT_RUNNING_STATE) && !creature.IsLevitating(), false);
 
@@ -524,6 +519,8 @@ bool WaypointMovementGenerator<Creature>::Update(Creature& creature, const uint3
         return true;
     }
 
+    ClampCurrentIndex();
+
     if (Stopped(creature))
     {
         // If a script just have set the waypoint to be paused or stopped we have to check
@@ -560,7 +557,7 @@ bool WaypointMovementGenerator<Creature>::Update(Creature& creature, const uint3
                 if (m_pathDuration <= 0)
                 {
                     // time to send new packet
-                    if (m_currentWaypointNode->second.delay == 0)
+                    if (GetCurrentEntry().second.delay == 0)
                         SendNextWayPointPath(creature);
                 }
                 else
@@ -670,8 +667,8 @@ bool WaypointMovementGenerator<Creature>::SetNextWaypoint(uint32 pointId)
     if (!i_path || i_path->empty())
         return false;
 
-    WaypointPath::const_iterator currPoint = i_path->find(pointId);
-    if (currPoint == i_path->end())
+    size_t currIndex = i_path->FindIndex(pointId);
+    if (currIndex >= i_path->size())
         return false;
 
     // Allow Moving with next tick
@@ -681,6 +678,6 @@ bool WaypointMovementGenerator<Creature>::SetNextWaypoint(uint32 pointId)
 
     // Set the point
     i_currentNode = pointId;
-    m_currentWaypointNode = currPoint;
+    m_currentWaypointIndex = currIndex;
     return true;
 }
@@ -72,7 +72,7 @@ class WaypointMovementGenerator<Creature>
 {
     public:
         WaypointMovementGenerator(Creature&) :
-            i_nextMoveTime(0), m_lastReachedWaypoint(0), m_pathId(0), m_PathOrigin(),
+            m_currentWaypointIndex(0), i_nextMoveTime(0), m_lastReachedWaypoint(0), m_pathId(0), m_PathOrigin(),
             m_scriptTime(0), m_pathDuration(0)
         {}
         ~WaypointMovementGenerator() { i_path = nullptr; }
@@ -95,17 +95,20 @@ class WaypointMovementGenerator<Creature>
 
     private:
         void LoadPath(Creature& creature, int32 pathId, WaypointPathOrigin wpOrigin, uint32 overwriteEntry);
-        uint32 BuildIntPath(Movement::PointsArray& path, Creature& creature, G3D::Vector3 const& endPos) const;
+        uint32 BuildIntPath(Movement::PointsArray& path, Creature& creature, G3D::Vector3 const& endPos, float knownDistance = -1.0f) const;
 
         void Stop(int32 time) { i_nextMoveTime.Reset(time); }
         bool Stopped(Creature& u);
         bool CanMove(int32 diff, Creature& u);
 
+        void ClampCurrentIndex() { if (m_currentWaypointIndex >= i_path->size()) m_currentWaypointIndex = 0; }
+        WaypointPathEntry const& GetCurrentEntry() const { return i_path->at(m_currentWaypointIndex); }
+
         void OnArrived(Creature&);
         void SendNextWayPointPath(Creature&);
         void InformAI(Creature& creature, uint32 type, uint32 data);
 
-        WaypointPath::const_iterator m_currentWaypointNode;
+        size_t m_currentWaypointIndex;                      // index in i_path, kept valid by ClampCurrentIndex() as GM edits may shrink the path
         ShortTimeTracker i_nextMoveTime;
         int32 m_scriptTime;                                 // filled with delay change when script is instantly executed and want to change node delay
         uint32 m_lastReachedWaypoint;
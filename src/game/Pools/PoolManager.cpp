@@ -139,9 +139,49 @@ template <class T>
 void PoolGroup<T>::AddEntry(PoolObject& poolitem, uint32 maxentries)
 {
     if (poolitem.chance != 0 && maxentries == 1)
+    {
         ExplicitlyChanced.push_back(poolitem);
+
+        uint32 index = ExplicitlyChanced.size() - 1;
+        ObjectIndex[poolitem.guid] = std::make_pair(true, index);
+        // keep entries of same chance in loading order
+        ExplicitlyChancedOrder.insert(std::upper_bound(ExplicitlyChancedOrder.begin(), ExplicitlyChancedOrder.end(), index,
+            [this](uint32 a, uint32 b) { return ExplicitlyChanced[a].chance > ExplicitlyChanced[b].chance; }), index);
+    }
     else
+    {
         EqualChanced.push_back(poolitem);
+        ObjectIndex[poolitem.guid] = std::make_pair(false, uint32(EqualChanced.size() - 1));
+    }
+}
+
+// Rebuild the lookup data after removal of entries (at loading stage)
+template <class T>
+void PoolGroup<T>::RebuildLookupData()
+{
+    ObjectIndex.clear();
+    ExplicitlyChancedOrder.clear();
+
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+    {
+        ObjectIndex[ExplicitlyChanced[i].guid] = std::make_pair(true, i);
+        ExplicitlyChancedOrder.push_back(i);
+    }
+    std::stable_sort(ExplicitlyChancedOrder.begin(), ExplicitlyChancedOrder.end(),
+        [this](uint32 a, uint32 b) { return ExplicitlyChanced[a].chance > ExplicitlyChanced[b].chance; });
+
+    for (uint32 i = 0; i < EqualChanced.size(); ++i)
+        ObjectIndex[EqualChanced[i].guid] = std::make_pair(false, i);
+}
+
+template <class T>
+PoolObject* PoolGroup<T>::FindObject(uint32 guid)
+{
+    PoolObjectIndex::const_iterator itr = ObjectIndex.find(guid);
+    if (itr == ObjectIndex.end())
+        return nullptr;
+
+    return itr->second.first ? &ExplicitlyChanced[itr->second.second] : &EqualChanced[itr->second.second];
 }
 
 // Method to check the chances are proper in this object pool
@@ -173,96 +213,69 @@ void PoolGroup<T>::CheckEventLinkAndReport(int16 event_id, std::map<uint32, int1
 template <class T>
 void PoolGroup<T>::SetExcludeObject(uint32 guid, bool state)
 {
-    for (uint32 i = 0; i < EqualChanced.size(); ++i)
+    if (PoolObject* obj = FindObject(guid))
+        obj->exclude = state;
+}
+
+// Pick with equal probability one of the objects [0, count) accepted by the filter, nullptr if none is accepted
+// Some random probes are tried first (most of the pool objects are usually not spawned), then all the objects are
+// scanned by reservoir sampling, so no temporary list or shuffle is needed
+template <typename ObjectAccessor, typename ObjectFilter>
+static PoolObject* PickPoolObject(uint32 count, ObjectAccessor getObject, ObjectFilter isCandidate)
+{
+    uint32 const POOL_ROLL_PROBES = 4;
+
+    if (!count)
+        return nullptr;
+
+    for (uint32 i = 0; i < POOL_ROLL_PROBES; ++i)
     {
-        if (EqualChanced[i].guid == guid)
-        {
-            EqualChanced[i].exclude = state;
-            return;
-        }
+        PoolObject* obj = getObject(urand(0, count - 1));
+        if (isCandidate(obj))
+            return obj;
     }
 
-    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+    PoolObject* picked = nullptr;
+    uint32 found = 0;
+    for (uint32 i = 0; i < count; ++i)
     {
-        if (ExplicitlyChanced[i].guid == guid)
-        {
-            ExplicitlyChanced[i].exclude = state;
-            return;
-        }
+        PoolObject* obj = getObject(i);
+        if (isCandidate(obj) && urand(0, found++) == 0)
+            picked = obj;
     }
+    return picked;
 }
 
+// Same result distribution as checking each object of a shuffled list in turn:
+// - an explicitly chanced object with a chance above the roll, any of them with the same probability
+// - else an equal chanced object
+// - else any explicitly chanced object
 template <class T>
 PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, MapPersistentState& mapState)
 {
-    PoolObject* explicitlyObjFound = nullptr;
-    auto gen = GetRandomGenerator();
+    auto isCandidate = [&](PoolObject* obj)
+    {
+        return !obj->exclude && (obj->guid == triggerFrom || !spawns.IsSpawnedObject<T>(obj->guid)) && CanSpawn(obj, mapState);
+    };
+    auto getExplicitlyChanced = [this](uint32 i) { return &ExplicitlyChanced[ExplicitlyChancedOrder[i]]; };
 
     if (!ExplicitlyChanced.empty())
     {
         float roll = (float)rand_chance();
 
-        std::vector <PoolObject*> explicitlyChancedVector;
-
-        // call memory manager once to reserve enough memory for performance
-        explicitlyChancedVector.reserve(ExplicitlyChanced.size());
-
-        // fill new vector with address of object in EqualChanced list
-        std::transform(ExplicitlyChanced.begin(), ExplicitlyChanced.end(), std::back_inserter(explicitlyChancedVector), [](PoolObject& objPtr) { return &objPtr; });
-
-        // randomize the new vector
-        std::shuffle(explicitlyChancedVector.begin(), explicitlyChancedVector.end(), *gen);
-
-        for (auto obj : explicitlyChancedVector)
-        {
-            if (obj->exclude)
-                continue;
-
-            if (!CanSpawn(obj, mapState))
-                continue;
-
-            if (obj->guid != triggerFrom && spawns.IsSpawnedObject<T>(obj->guid))
-                continue;
-
-            // we found an object but it may have no luck to be picked so we save it in case of no other object have been picked.
-            if (!explicitlyObjFound)
-                explicitlyObjFound = obj;
-
-            if (roll < obj->chance)
-                return obj;
-        }
-    }
-
-    if (!EqualChanced.empty())
-    {
-        std::vector <PoolObject*> equalyChancedVector;
-
-        // call memory manager once to reserve enough memory for performance
-        equalyChancedVector.reserve(EqualChanced.size());
-
-        // fill new vector with address of object in EqualChanced list
-        std::transform(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(equalyChancedVector), [](PoolObject& objPtr) { return &objPtr; });
-
-        // randomize the new vector
-        std::shuffle(equalyChancedVector.begin(), equalyChancedVector.end(), *gen);
-
-        for (auto obj : equalyChancedVector)
-        {
-            if (obj->exclude)
-                continue;
-
-            if (!CanSpawn(obj, mapState))
-                continue;
-
-            if (obj->guid != triggerFrom && spawns.IsSpawnedObject<T>(obj->guid))
-                continue;
+        // objects with a chance above the roll are the first ones of ExplicitlyChancedOrder
+        uint32 luckyCount = std::partition_point(ExplicitlyChancedOrder.begin(), ExplicitlyChancedOrder.end(),
+            [this, roll](uint32 i) { return roll < ExplicitlyChanced[i].chance; }) - ExplicitlyChancedOrder.begin();
 
+        if (PoolObject* obj = PickPoolObject(luckyCount, getExplicitlyChanced, isCandidate))
             return obj;
-        }
     }
 
-    // return first explicitly chanced object if there is one
-    return explicitlyObjFound;
+    if (PoolObject* obj = PickPoolObject(EqualChanced.size(), [this](uint32 i) { return &EqualChanced[i]; }, isCandidate))
+        return obj;
+
+    // return an explicitly chanced object if there is one, even if it had no luck
+    return PickPoolObject(ExplicitlyChanced.size(), getExplicitlyChanced, isCandidate);
 }
 
 // Main method to despawn a creature or gameobject in a pool
@@ -271,17 +284,23 @@ PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, M
 template<class T>
 void PoolGroup<T>::DespawnObject(MapPersistentState& mapState, uint32 guid)
 {
+    if (guid)
+    {
+        if (FindObject(guid) && mapState.GetSpawnedPoolData().IsSpawnedObject<T>(guid))
+        {
+            Despawn1Object(mapState, guid);
+            mapState.GetSpawnedPoolData().RemoveSpawn<T>(guid, poolId);
+        }
+        return;
+    }
+
     for (size_t i = 0; i < EqualChanced.size(); ++i)
     {
         // if spawned
         if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(EqualChanced[i].guid))
         {
-            // any or specially requested
-            if (!guid || EqualChanced[i].guid == guid)
-            {
-                Despawn1Object(mapState, EqualChanced[i].guid);
-                mapState.GetSpawnedPoolData().RemoveSpawn<T>(EqualChanced[i].guid, poolId);
-            }
+            Despawn1Object(mapState, EqualChanced[i].guid);
+            mapState.GetSpawnedPoolData().RemoveSpawn<T>(EqualChanced[i].guid, poolId);
         }
     }
 
@@ -290,12 +309,8 @@ void PoolGroup<T>::DespawnObject(MapPersistentState& mapState, uint32 guid)
         // spawned
         if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(ExplicitlyChanced[i].guid))
         {
-            // any or specially requested
-            if (!guid || ExplicitlyChanced[i].guid == guid)
-            {
-                Despawn1Object(mapState, ExplicitlyChanced[i].guid);
-                mapState.GetSpawnedPoolData().RemoveSpawn<T>(ExplicitlyChanced[i].guid, poolId);
-            }
+            Despawn1Object(mapState, ExplicitlyChanced[i].guid);
+            mapState.GetSpawnedPoolData().RemoveSpawn<T>(ExplicitlyChanced[i].guid, poolId);
         }
     }
 }
@@ -363,6 +378,7 @@ void PoolGroup<Pool>::RemoveOneRelation(uint16 child_pool_id)
             break;
         }
     }
+    RebuildLookupData();
 }
 
 template<>
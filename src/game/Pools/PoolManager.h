@@ -24,6 +24,8 @@
 #include "Entities/Creature.h"
 #include "Entities/GameObject.h"
 
+#include <unordered_map>
+
 class MapPersistentState;
 struct MapEntry;
 
@@ -122,10 +124,16 @@ class PoolGroup
         size_t size() const { return ExplicitlyChanced.size() + EqualChanced.size(); }
     private:
         bool CanSpawn(PoolObject* object, MapPersistentState& mapState);
-        
+        PoolObject* FindObject(uint32 guid);
+        void RebuildLookupData();
+
+        typedef std::unordered_map<uint32 /*guid*/, std::pair<bool /*explicitly chanced*/, uint32 /*index in list*/> > PoolObjectIndex;
+
         uint32 poolId;
         PoolObjectList ExplicitlyChanced;
         PoolObjectList EqualChanced;
+        PoolObjectIndex ObjectIndex;                        // position of the objects in the lists (kept at loading stage)
+        std::vector<uint32> ExplicitlyChancedOrder;         // ExplicitlyChanced indexes sorted by decreasing chance, used by RollOne
 };
 
 class PoolManager
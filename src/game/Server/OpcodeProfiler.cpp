@@ -0,0 +1,166 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/OpcodeProfiler.h"
+#include "Server/Opcodes.h"
+#include "Policies/Singleton.h"
+#include "Metric/Metric.h"
+
+#define CLASS_LOCK MaNGOS::ClassLevelLockable<OpcodeProfiler, std::mutex>
+INSTANTIATE_SINGLETON_2(OpcodeProfiler, CLASS_LOCK);
+
+uint64 OpcodeProfile::GetPercentile(double fraction) const
+{
+    uint64 target = uint64(handled * fraction);
+    uint64 seen = 0;
+    for (uint32 i = 0; i < OPCODE_PROFILER_BUCKETS; ++i)
+    {
+        seen += buckets[i];
+        if (seen > target)
+            return uint64(1) << i;
+    }
+    return uint64(1) << (OPCODE_PROFILER_BUCKETS - 1);
+}
+
+OpcodeProfiler::ThreadCounters::ThreadCounters() : opcodes(NUM_MSG_TYPES) {}
+
+OpcodeProfiler::OpcodeProfiler() : m_resetSnapshot(NUM_MSG_TYPES), m_metricSnapshot(NUM_MSG_TYPES) {}
+
+OpcodeProfiler::ThreadCounters& OpcodeProfiler::GetThreadCounters()
+{
+    static thread_local ThreadCounters* counters = nullptr;
+    if (!counters)
+    {
+        std::lock_guard<std::mutex> guard(m_threadCountersLock);
+        m_threadCounters.emplace_back(new ThreadCounters());
+        counters = m_threadCounters.back().get();
+    }
+    return *counters;
+}
+
+void OpcodeProfiler::RecordHandler(uint16 opcode, std::chrono::steady_clock::duration elapsed)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    uint64 time = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    // bucket i holds [2^(i-1), 2^i) microseconds
+    uint32 bucket = 0;
+    for (uint64 bound = time; bound && bucket < OPCODE_PROFILER_BUCKETS - 1; bound >>= 1)
+        ++bucket;
+
+    OpcodeCounters& counters = GetThreadCounters().opcodes[opcode];
+    counters.handled.Add(1);
+    counters.handlerTime.Add(time);
+    counters.buckets[bucket].Add(1);
+}
+
+void OpcodeProfiler::RecordSend(uint16 opcode, size_t bytes)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    OpcodeCounters& counters = GetThreadCounters().opcodes[opcode];
+    counters.sentPackets.Add(1);
+    counters.sentBytes.Add(bytes);
+}
+
+void OpcodeProfiler::Collect(OpcodeProfileList& profiles) const
+{
+    profiles.assign(NUM_MSG_TYPES, OpcodeProfile());
+
+    std::lock_guard<std::mutex> guard(m_threadCountersLock);
+    for (auto const& thread : m_threadCounters)
+    {
+        for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+        {
+            OpcodeCounters const& counters = thread->opcodes[i];
+            OpcodeProfile& profile = profiles[i];
+            profile.handled += counters.handled.Get();
+            profile.handlerTime += counters.handlerTime.Get();
+            profile.sentPackets += counters.sentPackets.Get();
+            profile.sentBytes += counters.sentBytes.Get();
+            for (uint32 j = 0; j < OPCODE_PROFILER_BUCKETS; ++j)
+                profile.buckets[j] += counters.buckets[j].Get();
+        }
+    }
+}
+
+static void SubtractProfiles(OpcodeProfileList& profiles, OpcodeProfileList const& snapshot)
+{
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+    {
+        profiles[i].handled -= snapshot[i].handled;
+        profiles[i].handlerTime -= snapshot[i].handlerTime;
+        profiles[i].sentPackets -= snapshot[i].sentPackets;
+        profiles[i].sentBytes -= snapshot[i].sentBytes;
+        for (uint32 j = 0; j < OPCODE_PROFILER_BUCKETS; ++j)
+            profiles[i].buckets[j] -= snapshot[i].buckets[j];
+    }
+}
+
+void OpcodeProfiler::GetProfiles(OpcodeProfileList& profiles) const
+{
+    Collect(profiles);
+
+    std::lock_guard<std::mutex> guard(m_snapshotLock);
+    SubtractProfiles(profiles, m_resetSnapshot);
+}
+
+void OpcodeProfiler::Reset()
+{
+    OpcodeProfileList totals;
+    Collect(totals);
+
+    std::lock_guard<std::mutex> guard(m_snapshotLock);
+    m_resetSnapshot.swap(totals);
+}
+
+void OpcodeProfiler::GenerateMetrics()
+{
+    OpcodeProfileList totals;
+    Collect(totals);
+
+    OpcodeProfileList interval(totals);
+    {
+        std::lock_guard<std::mutex> guard(m_snapshotLock);
+        SubtractProfiles(interval, m_metricSnapshot);
+        m_metricSnapshot.swap(totals);
+    }
+
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+    {
+        OpcodeProfile const& profile = interval[i];
+        if (profile.handled)
+        {
+            metric::measurement meas("world.metrics.packets.handled", { {"opcode", LookupOpcodeName(i)} });
+            meas.add_field("count", std::to_string(profile.handled));
+            meas.add_field("time_us", std::to_string(profile.handlerTime));
+            meas.add_field("p50_us", std::to_string(profile.GetPercentile(0.5)));
+            meas.add_field("p99_us", std::to_string(profile.GetPercentile(0.99)));
+        }
+
+        if (profile.sentPackets)
+        {
+            metric::measurement meas("world.metrics.packets.sent", { {"opcode", LookupOpcodeName(i)} });
+            meas.add_field("count", std::to_string(profile.sentPackets));
+            meas.add_field("bytes", std::to_string(profile.sentBytes));
+        }
+    }
+}
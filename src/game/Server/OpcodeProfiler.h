@@ -0,0 +1,112 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OPCODE_PROFILER_H
+#define MANGOS_OPCODE_PROFILER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// handler time histogram buckets: [0,1) [1,2) [2,4) ... microseconds, the last bucket holds everything above
+#define OPCODE_PROFILER_BUCKETS 20
+
+struct OpcodeProfile
+{
+    OpcodeProfile() : handled(0), handlerTime(0), sentPackets(0), sentBytes(0), buckets() {}
+
+    uint64 handled;                                         // handler calls
+    uint64 handlerTime;                                     // summed handler time in microseconds
+    uint64 sentPackets;
+    uint64 sentBytes;
+    uint64 buckets[OPCODE_PROFILER_BUCKETS];
+
+    // upper bound in microseconds of the bucket holding the given fraction of the handler calls
+    uint64 GetPercentile(double fraction) const;
+};
+
+typedef std::vector<OpcodeProfile> OpcodeProfileList;
+
+/**
+ * Always-on per opcode counters for handled and sent packets.
+ *
+ * Every thread writes only into its own counter block, so recording costs a few relaxed stores.
+ * Readers sum all blocks; the totals only grow and intervals are computed against a saved snapshot.
+ */
+class OpcodeProfiler
+{
+    public:
+        OpcodeProfiler();
+
+        void RecordHandler(uint16 opcode, std::chrono::steady_clock::duration elapsed);
+        void RecordSend(uint16 opcode, size_t bytes);
+
+        // totals since the last Reset()
+        void GetProfiles(OpcodeProfileList& profiles) const;
+        void Reset();
+
+        // report the interval since the previous call to the metric system
+        void GenerateMetrics();
+
+    private:
+        struct Counter
+        {
+            Counter() : value(0) {}
+            std::atomic<uint64> value;
+
+            // single writer: the owning thread
+            void Add(uint64 amount) { value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); }
+            uint64 Get() const { return value.load(std::memory_order_relaxed); }
+        };
+
+        struct OpcodeCounters
+        {
+            Counter handled;
+            Counter handlerTime;
+            Counter sentPackets;
+            Counter sentBytes;
+            Counter buckets[OPCODE_PROFILER_BUCKETS];
+        };
+
+        struct ThreadCounters
+        {
+            ThreadCounters();
+            std::vector<OpcodeCounters> opcodes;
+        };
+
+        ThreadCounters& GetThreadCounters();
+        void Collect(OpcodeProfileList& profiles) const;
+
+        // blocks are never freed before shutdown, a finished thread keeps its totals
+        std::vector<std::unique_ptr<ThreadCounters>> m_threadCounters;
+        mutable std::mutex m_threadCountersLock;
+
+        mutable std::mutex m_snapshotLock;
+        OpcodeProfileList m_resetSnapshot;                  // totals at the last Reset()
+        OpcodeProfileList m_metricSnapshot;                 // totals at the last GenerateMetrics()
+};
+
+// first use may come from any map thread
+#define sOpcodeProfiler MaNGOS::Singleton<OpcodeProfiler, MaNGOS::ClassLevelLockable<OpcodeProfiler, std::mutex> >::Instance()
+
+#endif
@@ -23,27 +23,43 @@
 #include "Server/Opcodes.h"
 #include "Policies/Singleton.h"
 
+#include <algorithm>
+#include <iterator>
+
 INSTANTIATE_SINGLETON_1(Opcodes);
 
 OpcodeHandler const Opcodes::emptyHandler =
 {
-    "<none>",
+    &WorldSession::Handle_NULL,
     STATUS_UNHANDLED,
     PROCESS_INPLACE,
-    &WorldSession::Handle_NULL
+    0
 };
 
 
 Opcodes::Opcodes()
 {
-    /// Build Opcodes map
+    std::fill(std::begin(mOpcodes), std::end(mOpcodes), emptyHandler);
+    std::fill(std::begin(mOpcodeNames), std::end(mOpcodeNames), nullptr);
+
+    /// Build Opcodes table
     BuildOpcodeList();
 }
 
 Opcodes::~Opcodes()
 {
-    /// Clear Opcodes
-    mOpcodeMap.clear();
+}
+
+uint8 Opcodes::GetAllowedStates(SessionStatus status)
+{
+    switch (status)
+    {
+        case STATUS_AUTHED:                         return SESSION_STATE_MASK_AUTHED;
+        case STATUS_LOGGEDIN:                       return SESSION_STATE_MASK_IN_WORLD;
+        case STATUS_TRANSFER:                       return SESSION_STATE_MASK_TRANSFER;
+        case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT: return SESSION_STATE_MASK_IN_WORLD | SESSION_STATE_MASK_TRANSFER | SESSION_STATE_MASK_RECENTLY_LOGOUT;
+        default:                                    return 0;
+    }
 }
 
 
@@ -140,9 +156,9 @@ void Opcodes::BuildOpcodeList()
     /*0x057*/  StoreOpcode(CMSG_ITEM_QUERY_MULTIPLE,          "CMSG_ITEM_QUERY_MULTIPLE",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x058*/  StoreOpcode(SMSG_ITEM_QUERY_SINGLE_RESPONSE,   "SMSG_ITEM_QUERY_SINGLE_RESPONSE",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x059*/  StoreOpcode(SMSG_ITEM_QUERY_MULTIPLE_RESPONSE, "SMSG_ITEM_QUERY_MULTIPLE_RESPONSE", STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x05A*/  StoreOpcode(CMSG_PAGE_TEXT_QUERY,              "CMSG_PAGE_TEXT_QUERY",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePageTextQueryOpcode);
+    /*0x05A*/  StoreOpcode(CMSG_PAGE_TEXT_QUERY,              "CMSG_PAGE_TEXT_QUERY",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePageTextQueryOpcode);
     /*0x05B*/  StoreOpcode(SMSG_PAGE_TEXT_QUERY_RESPONSE,     "SMSG_PAGE_TEXT_QUERY_RESPONSE",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x05C*/  StoreOpcode(CMSG_QUEST_QUERY,                  "CMSG_QUEST_QUERY",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQuestQueryOpcode);
+    /*0x05C*/  StoreOpcode(CMSG_QUEST_QUERY,                  "CMSG_QUEST_QUERY",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleQuestQueryOpcode);
     /*0x05D*/  StoreOpcode(SMSG_QUEST_QUERY_RESPONSE,         "SMSG_QUEST_QUERY_RESPONSE",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x05E*/  StoreOpcode(CMSG_GAMEOBJECT_QUERY,             "CMSG_GAMEOBJECT_QUERY",            STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleGameObjectQueryOpcode);
     /*0x05F*/  StoreOpcode(SMSG_GAMEOBJECT_QUERY_RESPONSE,    "SMSG_GAMEOBJECT_QUERY_RESPONSE",   STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -199,7 +215,7 @@ void Opcodes::BuildOpcodeList()
     /*0x092*/  StoreOpcode(SMSG_GUILD_EVENT,                  "SMSG_GUILD_EVENT",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x093*/  StoreOpcode(SMSG_GUILD_COMMAND_RESULT,         "SMSG_GUILD_COMMAND_RESULT",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x094*/  StoreOpcode(UMSG_UPDATE_GUILD,                 "UMSG_UPDATE_GUILD",                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x095*/  StoreOpcode(CMSG_MESSAGECHAT,                  "CMSG_MESSAGECHAT",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleMessagechatOpcode);
+    /*0x095*/  StoreOpcode(CMSG_MESSAGECHAT,                  "CMSG_MESSAGECHAT",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMessagechatOpcode);
     /*0x096*/  StoreOpcode(SMSG_MESSAGECHAT,                  "SMSG_MESSAGECHAT",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x097*/  StoreOpcode(CMSG_JOIN_CHANNEL,                 "CMSG_JOIN_CHANNEL",                STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleJoinChannelOpcode);
     /*0x098*/  StoreOpcode(CMSG_LEAVE_CHANNEL,                "CMSG_LEAVE_CHANNEL",               STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleLeaveChannelOpcode);
@@ -221,9 +237,9 @@ void Opcodes::BuildOpcodeList()
     /*0x0A8*/  StoreOpcode(CMSG_CHANNEL_MODERATE,             "CMSG_CHANNEL_MODERATE",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleChannelModerateOpcode);
     /*0x0A9*/  StoreOpcode(SMSG_UPDATE_OBJECT,                "SMSG_UPDATE_OBJECT",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0AA*/  StoreOpcode(SMSG_DESTROY_OBJECT,               "SMSG_DESTROY_OBJECT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0AB*/  StoreOpcode(CMSG_USE_ITEM,                     "CMSG_USE_ITEM",                    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleUseItemOpcode);
+    /*0x0AB*/  StoreOpcode(CMSG_USE_ITEM,                     "CMSG_USE_ITEM",                    STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleUseItemOpcode);
     /*0x0AC*/  StoreOpcode(CMSG_OPEN_ITEM,                    "CMSG_OPEN_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleOpenItemOpcode);
-    /*0x0AD*/  StoreOpcode(CMSG_READ_ITEM,                    "CMSG_READ_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleReadItemOpcode);
+    /*0x0AD*/  StoreOpcode(CMSG_READ_ITEM,                    "CMSG_READ_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleReadItemOpcode);
     /*0x0AE*/  StoreOpcode(SMSG_READ_ITEM_OK,                 "SMSG_READ_ITEM_OK",                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0AF*/  StoreOpcode(SMSG_READ_ITEM_FAILED,             "SMSG_READ_ITEM_FAILED",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0B0*/  StoreOpcode(SMSG_ITEM_COOLDOWN,                "SMSG_ITEM_COOLDOWN",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -304,26 +320,26 @@ void Opcodes::BuildOpcodeList()
     /*0x0FB*/  StoreOpcode(CMSG_NEXT_CINEMATIC_CAMERA,        "CMSG_NEXT_CINEMATIC_CAMERA",       STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleNextCinematicCamera);
     /*0x0FC*/  StoreOpcode(CMSG_COMPLETE_CINEMATIC,           "CMSG_COMPLETE_CINEMATIC",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCompleteCinematic);
     /*0x0FD*/  StoreOpcode(SMSG_TUTORIAL_FLAGS,               "SMSG_TUTORIAL_FLAGS",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0FE*/  StoreOpcode(CMSG_TUTORIAL_FLAG,                "CMSG_TUTORIAL_FLAG",               STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTutorialFlagOpcode);
-    /*0x0FF*/  StoreOpcode(CMSG_TUTORIAL_CLEAR,               "CMSG_TUTORIAL_CLEAR",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTutorialClearOpcode);
-    /*0x100*/  StoreOpcode(CMSG_TUTORIAL_RESET,               "CMSG_TUTORIAL_RESET",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTutorialResetOpcode);
+    /*0x0FE*/  StoreOpcode(CMSG_TUTORIAL_FLAG,                "CMSG_TUTORIAL_FLAG",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleTutorialFlagOpcode);
+    /*0x0FF*/  StoreOpcode(CMSG_TUTORIAL_CLEAR,               "CMSG_TUTORIAL_CLEAR",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleTutorialClearOpcode);
+    /*0x100*/  StoreOpcode(CMSG_TUTORIAL_RESET,               "CMSG_TUTORIAL_RESET",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleTutorialResetOpcode);
     /*0x101*/  StoreOpcode(CMSG_STANDSTATECHANGE,             "CMSG_STANDSTATECHANGE",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleStandStateChangeOpcode);
-    /*0x102*/  StoreOpcode(CMSG_EMOTE,                        "CMSG_EMOTE",                       STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleEmoteOpcode);
+    /*0x102*/  StoreOpcode(CMSG_EMOTE,                        "CMSG_EMOTE",                       STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleEmoteOpcode);
     /*0x103*/  StoreOpcode(SMSG_EMOTE,                        "SMSG_EMOTE",                       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x104*/  StoreOpcode(CMSG_TEXT_EMOTE,                   "CMSG_TEXT_EMOTE",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTextEmoteOpcode);
+    /*0x104*/  StoreOpcode(CMSG_TEXT_EMOTE,                   "CMSG_TEXT_EMOTE",                  STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleTextEmoteOpcode);
     /*0x105*/  StoreOpcode(SMSG_TEXT_EMOTE,                   "SMSG_TEXT_EMOTE",                  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x106*/  StoreOpcode(CMSG_AUTOEQUIP_GROUND_ITEM,        "CMSG_AUTOEQUIP_GROUND_ITEM",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x107*/  StoreOpcode(CMSG_AUTOSTORE_GROUND_ITEM,        "CMSG_AUTOSTORE_GROUND_ITEM",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x108*/  StoreOpcode(CMSG_AUTOSTORE_LOOT_ITEM,          "CMSG_AUTOSTORE_LOOT_ITEM",         STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAutostoreLootItemOpcode);
     /*0x109*/  StoreOpcode(CMSG_STORE_LOOT_IN_SLOT,           "CMSG_STORE_LOOT_IN_SLOT",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x10A*/  StoreOpcode(CMSG_AUTOEQUIP_ITEM,               "CMSG_AUTOEQUIP_ITEM",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAutoEquipItemOpcode);
-    /*0x10B*/  StoreOpcode(CMSG_AUTOSTORE_BAG_ITEM,           "CMSG_AUTOSTORE_BAG_ITEM",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAutoStoreBagItemOpcode);
-    /*0x10C*/  StoreOpcode(CMSG_SWAP_ITEM,                    "CMSG_SWAP_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSwapItem);
-    /*0x10D*/  StoreOpcode(CMSG_SWAP_INV_ITEM,                "CMSG_SWAP_INV_ITEM",               STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSwapInvItemOpcode);
-    /*0x10E*/  StoreOpcode(CMSG_SPLIT_ITEM,                   "CMSG_SPLIT_ITEM",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSplitItemOpcode);
-    /*0x10F*/  StoreOpcode(CMSG_AUTOEQUIP_ITEM_SLOT,          "CMSG_AUTOEQUIP_ITEM_SLOT",         STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAutoEquipItemSlotOpcode);
+    /*0x10A*/  StoreOpcode(CMSG_AUTOEQUIP_ITEM,               "CMSG_AUTOEQUIP_ITEM",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleAutoEquipItemOpcode);
+    /*0x10B*/  StoreOpcode(CMSG_AUTOSTORE_BAG_ITEM,           "CMSG_AUTOSTORE_BAG_ITEM",          STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleAutoStoreBagItemOpcode);
+    /*0x10C*/  StoreOpcode(CMSG_SWAP_ITEM,                    "CMSG_SWAP_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSwapItem);
+    /*0x10D*/  StoreOpcode(CMSG_SWAP_INV_ITEM,                "CMSG_SWAP_INV_ITEM",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSwapInvItemOpcode);
+    /*0x10E*/  StoreOpcode(CMSG_SPLIT_ITEM,                   "CMSG_SPLIT_ITEM",                  STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSplitItemOpcode);
+    /*0x10F*/  StoreOpcode(CMSG_AUTOEQUIP_ITEM_SLOT,          "CMSG_AUTOEQUIP_ITEM_SLOT",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleAutoEquipItemSlotOpcode);
     /*0x110*/  StoreOpcode(OBSOLETE_DROP_ITEM,                "OBSOLETE_DROP_ITEM",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x111*/  StoreOpcode(CMSG_DESTROYITEM,                  "CMSG_DESTROYITEM",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleDestroyItemOpcode);
+    /*0x111*/  StoreOpcode(CMSG_DESTROYITEM,                  "CMSG_DESTROYITEM",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleDestroyItemOpcode);
     /*0x112*/  StoreOpcode(SMSG_INVENTORY_CHANGE_FAILURE,     "SMSG_INVENTORY_CHANGE_FAILURE",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x113*/  StoreOpcode(SMSG_OPEN_CONTAINER,               "SMSG_OPEN_CONTAINER",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x114*/  StoreOpcode(CMSG_INSPECT,                      "CMSG_INSPECT",                     STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleInspectOpcode);
@@ -343,10 +359,10 @@ void Opcodes::BuildOpcodeList()
     /*0x122*/  StoreOpcode(SMSG_INITIALIZE_FACTIONS,          "SMSG_INITIALIZE_FACTIONS",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x123*/  StoreOpcode(SMSG_SET_FACTION_VISIBLE,          "SMSG_SET_FACTION_VISIBLE",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x124*/  StoreOpcode(SMSG_SET_FACTION_STANDING,         "SMSG_SET_FACTION_STANDING",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x125*/  StoreOpcode(CMSG_SET_FACTION_ATWAR,            "CMSG_SET_FACTION_ATWAR",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetFactionAtWarOpcode);
+    /*0x125*/  StoreOpcode(CMSG_SET_FACTION_ATWAR,            "CMSG_SET_FACTION_ATWAR",           STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSetFactionAtWarOpcode);
     /*0x126*/  StoreOpcode(CMSG_SET_FACTION_CHEAT,            "CMSG_SET_FACTION_CHEAT",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_Deprecated);
     /*0x127*/  StoreOpcode(SMSG_SET_PROFICIENCY,              "SMSG_SET_PROFICIENCY",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x128*/  StoreOpcode(CMSG_SET_ACTION_BUTTON,            "CMSG_SET_ACTION_BUTTON",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetActionButtonOpcode);
+    /*0x128*/  StoreOpcode(CMSG_SET_ACTION_BUTTON,            "CMSG_SET_ACTION_BUTTON",           STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSetActionButtonOpcode);
     /*0x129*/  StoreOpcode(SMSG_ACTION_BUTTONS,               "SMSG_ACTION_BUTTONS",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x12A*/  StoreOpcode(SMSG_INITIAL_SPELLS,               "SMSG_INITIAL_SPELLS",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x12B*/  StoreOpcode(SMSG_LEARNED_SPELL,                "SMSG_LEARNED_SPELL",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -360,12 +376,12 @@ void Opcodes::BuildOpcodeList()
     /*0x133*/  StoreOpcode(SMSG_SPELL_FAILURE,                "SMSG_SPELL_FAILURE",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x134*/  StoreOpcode(SMSG_SPELL_COOLDOWN,               "SMSG_SPELL_COOLDOWN",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x135*/  StoreOpcode(SMSG_COOLDOWN_EVENT,               "SMSG_COOLDOWN_EVENT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x136*/  StoreOpcode(CMSG_CANCEL_AURA,                  "CMSG_CANCEL_AURA",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelAuraOpcode);
+    /*0x136*/  StoreOpcode(CMSG_CANCEL_AURA,                  "CMSG_CANCEL_AURA",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelAuraOpcode);
     /*0x137*/  StoreOpcode(SMSG_UPDATE_AURA_DURATION,         "SMSG_UPDATE_AURA_DURATION",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x138*/  StoreOpcode(SMSG_PET_CAST_FAILED,              "SMSG_PET_CAST_FAILED",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x139*/  StoreOpcode(MSG_CHANNEL_START,                 "MSG_CHANNEL_START",                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x13A*/  StoreOpcode(MSG_CHANNEL_UPDATE,                "MSG_CHANNEL_UPDATE",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x13B*/  StoreOpcode(CMSG_CANCEL_CHANNELLING,           "CMSG_CANCEL_CHANNELLING",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelChanneling);
+    /*0x13B*/  StoreOpcode(CMSG_CANCEL_CHANNELLING,           "CMSG_CANCEL_CHANNELLING",          STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelChanneling);
     /*0x13C*/  StoreOpcode(SMSG_AI_REACTION,                  "SMSG_AI_REACTION",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x13D*/  StoreOpcode(CMSG_SET_SELECTION,                "CMSG_SET_SELECTION",               STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleSetSelectionOpcode);
     /*0x13E*/  StoreOpcode(CMSG_SET_TARGET_OBSOLETE,          "CMSG_SET_TARGET_OBSOLETE",         STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleSetTargetOpcode);
@@ -419,11 +435,11 @@ void Opcodes::BuildOpcodeList()
     /*0x16E*/  StoreOpcode(SMSG_MOUNTRESULT,                  "SMSG_MOUNTRESULT",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x16F*/  StoreOpcode(SMSG_DISMOUNTRESULT,               "SMSG_DISMOUNTRESULT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x170*/  StoreOpcode(SMSG_PUREMOUNT_CANCELLED_OBSOLETE, "SMSG_PUREMOUNT_CANCELLED_OBSOLETE", STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x171*/  StoreOpcode(CMSG_MOUNTSPECIAL_ANIM,            "CMSG_MOUNTSPECIAL_ANIM",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleMountSpecialAnimOpcode);
+    /*0x171*/  StoreOpcode(CMSG_MOUNTSPECIAL_ANIM,            "CMSG_MOUNTSPECIAL_ANIM",           STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMountSpecialAnimOpcode);
     /*0x172*/  StoreOpcode(SMSG_MOUNTSPECIAL_ANIM,            "SMSG_MOUNTSPECIAL_ANIM",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x173*/  StoreOpcode(SMSG_PET_TAME_FAILURE,             "SMSG_PET_TAME_FAILURE",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x174*/  StoreOpcode(CMSG_PET_SET_ACTION,               "CMSG_PET_SET_ACTION",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetSetAction);
-    /*0x175*/  StoreOpcode(CMSG_PET_ACTION,                   "CMSG_PET_ACTION",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetAction);
+    /*0x174*/  StoreOpcode(CMSG_PET_SET_ACTION,               "CMSG_PET_SET_ACTION",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePetSetAction);
+    /*0x175*/  StoreOpcode(CMSG_PET_ACTION,                   "CMSG_PET_ACTION",                  STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePetAction);
     /*0x176*/  StoreOpcode(CMSG_PET_ABANDON,                  "CMSG_PET_ABANDON",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetAbandon);
     /*0x177*/  StoreOpcode(CMSG_PET_RENAME,                   "CMSG_PET_RENAME",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetRename);
     /*0x178*/  StoreOpcode(SMSG_PET_NAME_INVALID,             "SMSG_PET_NAME_INVALID",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -433,10 +449,10 @@ void Opcodes::BuildOpcodeList()
     /*0x17C*/  StoreOpcode(CMSG_GOSSIP_SELECT_OPTION,         "CMSG_GOSSIP_SELECT_OPTION",        STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleGossipSelectOptionOpcode);
     /*0x17D*/  StoreOpcode(SMSG_GOSSIP_MESSAGE,               "SMSG_GOSSIP_MESSAGE",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x17E*/  StoreOpcode(SMSG_GOSSIP_COMPLETE,              "SMSG_GOSSIP_COMPLETE",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x17F*/  StoreOpcode(CMSG_NPC_TEXT_QUERY,               "CMSG_NPC_TEXT_QUERY",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleNpcTextQueryOpcode);
+    /*0x17F*/  StoreOpcode(CMSG_NPC_TEXT_QUERY,               "CMSG_NPC_TEXT_QUERY",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleNpcTextQueryOpcode);
     /*0x180*/  StoreOpcode(SMSG_NPC_TEXT_UPDATE,              "SMSG_NPC_TEXT_UPDATE",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x181*/  StoreOpcode(SMSG_NPC_WONT_TALK,                "SMSG_NPC_WONT_TALK",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x182*/  StoreOpcode(CMSG_QUESTGIVER_STATUS_QUERY,      "CMSG_QUESTGIVER_STATUS_QUERY",     STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQuestgiverStatusQueryOpcode);
+    /*0x182*/  StoreOpcode(CMSG_QUESTGIVER_STATUS_QUERY,      "CMSG_QUESTGIVER_STATUS_QUERY",     STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleQuestgiverStatusQueryOpcode);
     /*0x183*/  StoreOpcode(SMSG_QUESTGIVER_STATUS,            "SMSG_QUESTGIVER_STATUS",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x184*/  StoreOpcode(CMSG_QUESTGIVER_HELLO,             "CMSG_QUESTGIVER_HELLO",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQuestgiverHelloOpcode);
     /*0x185*/  StoreOpcode(SMSG_QUESTGIVER_QUEST_LIST,        "SMSG_QUESTGIVER_QUEST_LIST",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -464,12 +480,12 @@ void Opcodes::BuildOpcodeList()
     /*0x19B*/  StoreOpcode(CMSG_QUEST_CONFIRM_ACCEPT,         "CMSG_QUEST_CONFIRM_ACCEPT",        STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQuestConfirmAccept);
     /*0x19C*/  StoreOpcode(SMSG_QUEST_CONFIRM_ACCEPT,         "SMSG_QUEST_CONFIRM_ACCEPT",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x19D*/  StoreOpcode(CMSG_PUSHQUESTTOPARTY,             "CMSG_PUSHQUESTTOPARTY",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePushQuestToParty);
-    /*0x19E*/  StoreOpcode(CMSG_LIST_INVENTORY,               "CMSG_LIST_INVENTORY",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleListInventoryOpcode);
+    /*0x19E*/  StoreOpcode(CMSG_LIST_INVENTORY,               "CMSG_LIST_INVENTORY",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleListInventoryOpcode);
     /*0x19F*/  StoreOpcode(SMSG_LIST_INVENTORY,               "SMSG_LIST_INVENTORY",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x1A0*/  StoreOpcode(CMSG_SELL_ITEM,                    "CMSG_SELL_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSellItemOpcode);
+    /*0x1A0*/  StoreOpcode(CMSG_SELL_ITEM,                    "CMSG_SELL_ITEM",                   STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSellItemOpcode);
     /*0x1A1*/  StoreOpcode(SMSG_SELL_ITEM,                    "SMSG_SELL_ITEM",                   STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x1A2*/  StoreOpcode(CMSG_BUY_ITEM,                     "CMSG_BUY_ITEM",                    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleBuyItemOpcode);
-    /*0x1A3*/  StoreOpcode(CMSG_BUY_ITEM_IN_SLOT,             "CMSG_BUY_ITEM_IN_SLOT",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleBuyItemInSlotOpcode);
+    /*0x1A2*/  StoreOpcode(CMSG_BUY_ITEM,                     "CMSG_BUY_ITEM",                    STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleBuyItemOpcode);
+    /*0x1A3*/  StoreOpcode(CMSG_BUY_ITEM_IN_SLOT,             "CMSG_BUY_ITEM_IN_SLOT",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleBuyItemInSlotOpcode);
     /*0x1A4*/  StoreOpcode(SMSG_BUY_ITEM,                     "SMSG_BUY_ITEM",                    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1A5*/  StoreOpcode(SMSG_BUY_FAILED,                   "SMSG_BUY_FAILED",                  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1A6*/  StoreOpcode(CMSG_TAXICLEARALLNODES,            "CMSG_TAXICLEARALLNODES",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -546,7 +562,7 @@ void Opcodes::BuildOpcodeList()
     /*0x1ED*/  StoreOpcode(CMSG_AUTH_SESSION,                 "CMSG_AUTH_SESSION",                STATUS_NEVER,     PROCESS_THREADSAFE,   &WorldSession::Handle_EarlyProccess);
     /*0x1EE*/  StoreOpcode(SMSG_AUTH_RESPONSE,                "SMSG_AUTH_RESPONSE",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1EF*/  StoreOpcode(MSG_GM_SHOWLABEL,                  "MSG_GM_SHOWLABEL",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x1F0*/  StoreOpcode(CMSG_PET_CAST_SPELL,               "CMSG_PET_CAST_SPELL",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetCastSpellOpcode);
+    /*0x1F0*/  StoreOpcode(CMSG_PET_CAST_SPELL,               "CMSG_PET_CAST_SPELL",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePetCastSpellOpcode);
     /*0x1F1*/  StoreOpcode(MSG_SAVE_GUILD_EMBLEM,             "MSG_SAVE_GUILD_EMBLEM",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSaveGuildEmblemOpcode);
     /*0x1F2*/  StoreOpcode(MSG_TABARDVENDOR_ACTIVATE,         "MSG_TABARDVENDOR_ACTIVATE",        STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTabardVendorActivateOpcode);
     /*0x1F3*/  StoreOpcode(SMSG_PLAY_SPELL_VISUAL,            "SMSG_PLAY_SPELL_VISUAL",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -664,12 +680,12 @@ void Opcodes::BuildOpcodeList()
     /*0x265*/  StoreOpcode(SMSG_AUCTION_BIDDER_LIST_RESULT,   "SMSG_AUCTION_BIDDER_LIST_RESULT",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x266*/  StoreOpcode(SMSG_SET_FLAT_SPELL_MODIFIER,      "SMSG_SET_FLAT_SPELL_MODIFIER",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x267*/  StoreOpcode(SMSG_SET_PCT_SPELL_MODIFIER,       "SMSG_SET_PCT_SPELL_MODIFIER",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x268*/  StoreOpcode(CMSG_SET_AMMO,                     "CMSG_SET_AMMO",                    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetAmmoOpcode);
+    /*0x268*/  StoreOpcode(CMSG_SET_AMMO,                     "CMSG_SET_AMMO",                    STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSetAmmoOpcode);
     /*0x269*/  StoreOpcode(SMSG_CORPSE_RECLAIM_DELAY,         "SMSG_CORPSE_RECLAIM_DELAY",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x26A*/  StoreOpcode(CMSG_SET_ACTIVE_MOVER,             "CMSG_SET_ACTIVE_MOVER",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetActiveMoverOpcode);
-    /*0x26B*/  StoreOpcode(CMSG_PET_CANCEL_AURA,              "CMSG_PET_CANCEL_AURA",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetCancelAuraOpcode);
+    /*0x26B*/  StoreOpcode(CMSG_PET_CANCEL_AURA,              "CMSG_PET_CANCEL_AURA",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePetCancelAuraOpcode);
     /*0x26C*/  StoreOpcode(CMSG_PLAYER_AI_CHEAT,              "CMSG_PLAYER_AI_CHEAT",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x26D*/  StoreOpcode(CMSG_CANCEL_AUTO_REPEAT_SPELL,     "CMSG_CANCEL_AUTO_REPEAT_SPELL",    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelAutoRepeatSpellOpcode);
+    /*0x26D*/  StoreOpcode(CMSG_CANCEL_AUTO_REPEAT_SPELL,     "CMSG_CANCEL_AUTO_REPEAT_SPELL",    STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelAutoRepeatSpellOpcode);
     /*0x26E*/  StoreOpcode(MSG_GM_ACCOUNT_ONLINE,             "MSG_GM_ACCOUNT_ONLINE",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x26F*/  StoreOpcode(MSG_LIST_STABLED_PETS,             "MSG_LIST_STABLED_PETS",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleListStabledPetsOpcode);
     /*0x270*/  StoreOpcode(CMSG_STABLE_PET,                   "CMSG_STABLE_PET",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleStablePet);
@@ -681,7 +697,7 @@ void Opcodes::BuildOpcodeList()
     /*0x276*/  StoreOpcode(MSG_QUEST_PUSH_RESULT,             "MSG_QUEST_PUSH_RESULT",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQuestPushResult);
     /*0x277*/  StoreOpcode(SMSG_PLAY_MUSIC,                   "SMSG_PLAY_MUSIC",                  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x278*/  StoreOpcode(SMSG_PLAY_OBJECT_SOUND,            "SMSG_PLAY_OBJECT_SOUND",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x279*/  StoreOpcode(CMSG_REQUEST_PET_INFO,             "CMSG_REQUEST_PET_INFO",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleRequestPetInfoOpcode);
+    /*0x279*/  StoreOpcode(CMSG_REQUEST_PET_INFO,             "CMSG_REQUEST_PET_INFO",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleRequestPetInfoOpcode);
     /*0x27A*/  StoreOpcode(CMSG_FAR_SIGHT,                    "CMSG_FAR_SIGHT",                   STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleFarSightOpcode);
     /*0x27B*/  StoreOpcode(SMSG_SPELLDISPELLOG,               "SMSG_SPELLDISPELLOG",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x27C*/  StoreOpcode(SMSG_DAMAGE_CALC_LOG,              "SMSG_DAMAGE_CALC_LOG",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -690,8 +706,8 @@ void Opcodes::BuildOpcodeList()
     /*0x27F*/  StoreOpcode(CMSG_REQUEST_PARTY_MEMBER_STATS,   "CMSG_REQUEST_PARTY_MEMBER_STATS",  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleRequestPartyMemberStatsOpcode);
     /*0x280*/  StoreOpcode(CMSG_GROUP_SWAP_SUB_GROUP,         "CMSG_GROUP_SWAP_SUB_GROUP",        STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleGroupSwapSubGroupOpcode);
     /*0x281*/  StoreOpcode(CMSG_RESET_FACTION_CHEAT,          "CMSG_RESET_FACTION_CHEAT",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x282*/  StoreOpcode(CMSG_AUTOSTORE_BANK_ITEM,          "CMSG_AUTOSTORE_BANK_ITEM",         STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAutoStoreBankItemOpcode);
-    /*0x283*/  StoreOpcode(CMSG_AUTOBANK_ITEM,                "CMSG_AUTOBANK_ITEM",               STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAutoBankItemOpcode);
+    /*0x282*/  StoreOpcode(CMSG_AUTOSTORE_BANK_ITEM,          "CMSG_AUTOSTORE_BANK_ITEM",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleAutoStoreBankItemOpcode);
+    /*0x283*/  StoreOpcode(CMSG_AUTOBANK_ITEM,                "CMSG_AUTOBANK_ITEM",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleAutoBankItemOpcode);
     /*0x284*/  StoreOpcode(MSG_QUERY_NEXT_MAIL_TIME,          "MSG_QUERY_NEXT_MAIL_TIME",         STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQueryNextMailTime);
     /*0x285*/  StoreOpcode(SMSG_RECEIVED_MAIL,                "SMSG_RECEIVED_MAIL",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x286*/  StoreOpcode(SMSG_RAID_GROUP_ONLY,              "SMSG_RAID_GROUP_ONLY",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -704,7 +720,7 @@ void Opcodes::BuildOpcodeList()
     /*0x28D*/  StoreOpcode(SMSG_AUCTION_REMOVED_NOTIFICATION, "SMSG_AUCTION_REMOVED_NOTIFICATION", STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x28E*/  StoreOpcode(CMSG_GROUP_RAID_CONVERT,           "CMSG_GROUP_RAID_CONVERT",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleGroupRaidConvertOpcode);
     /*0x28F*/  StoreOpcode(CMSG_GROUP_ASSISTANT_LEADER,       "CMSG_GROUP_ASSISTANT_LEADER",      STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleGroupAssistantLeaderOpcode);
-    /*0x290*/  StoreOpcode(CMSG_BUYBACK_ITEM,                 "CMSG_BUYBACK_ITEM",                STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleBuybackItem);
+    /*0x290*/  StoreOpcode(CMSG_BUYBACK_ITEM,                 "CMSG_BUYBACK_ITEM",                STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleBuybackItem);
     /*0x291*/  StoreOpcode(SMSG_SERVER_MESSAGE,               "SMSG_SERVER_MESSAGE",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x292*/  StoreOpcode(CMSG_MEETINGSTONE_JOIN,            "CMSG_MEETINGSTONE_JOIN",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleMeetingStoneJoinOpcode);
     /*0x293*/  StoreOpcode(CMSG_MEETINGSTONE_LEAVE,           "CMSG_MEETINGSTONE_LEAVE",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -715,7 +731,7 @@ void Opcodes::BuildOpcodeList()
     /*0x298*/  StoreOpcode(SMSG_MEETINGSTONE_IN_PROGRESS,     "SMSG_MEETINGSTONE_IN_PROGRESS",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x299*/  StoreOpcode(SMSG_MEETINGSTONE_MEMBER_ADDED,    "SMSG_MEETINGSTONE_MEMBER_ADDED",   STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x29A*/  StoreOpcode(CMSG_GMTICKETSYSTEM_TOGGLE,        "CMSG_GMTICKETSYSTEM_TOGGLE",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x29B*/  StoreOpcode(CMSG_CANCEL_GROWTH_AURA,           "CMSG_CANCEL_GROWTH_AURA",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelGrowthAuraOpcode);
+    /*0x29B*/  StoreOpcode(CMSG_CANCEL_GROWTH_AURA,           "CMSG_CANCEL_GROWTH_AURA",          STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelGrowthAuraOpcode);
     /*0x29C*/  StoreOpcode(SMSG_CANCEL_AUTO_REPEAT,           "SMSG_CANCEL_AUTO_REPEAT",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x29D*/  StoreOpcode(SMSG_STANDSTATE_UPDATE,            "SMSG_STANDSTATE_UPDATE",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x29E*/  StoreOpcode(SMSG_LOOT_ALL_PASSED,              "SMSG_LOOT_ALL_PASSED",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -728,7 +744,7 @@ void Opcodes::BuildOpcodeList()
     /*0x2A5*/  StoreOpcode(SMSG_SET_FORCED_REACTIONS,         "SMSG_SET_FORCED_REACTIONS",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2A6*/  StoreOpcode(SMSG_SPELL_FAILED_OTHER,           "SMSG_SPELL_FAILED_OTHER",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2A7*/  StoreOpcode(SMSG_GAMEOBJECT_RESET_STATE,       "SMSG_GAMEOBJECT_RESET_STATE",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2A8*/  StoreOpcode(CMSG_REPAIR_ITEM,                  "CMSG_REPAIR_ITEM",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleRepairItemOpcode);
+    /*0x2A8*/  StoreOpcode(CMSG_REPAIR_ITEM,                  "CMSG_REPAIR_ITEM",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleRepairItemOpcode);
     /*0x2A9*/  StoreOpcode(SMSG_CHAT_PLAYER_NOT_FOUND,        "SMSG_CHAT_PLAYER_NOT_FOUND",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2AA*/  StoreOpcode(MSG_TALENT_WIPE_CONFIRM,           "MSG_TALENT_WIPE_CONFIRM",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTalentWipeConfirmOpcode);
     /*0x2AB*/  StoreOpcode(SMSG_SUMMON_REQUEST,               "SMSG_SUMMON_REQUEST",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -745,18 +761,18 @@ void Opcodes::BuildOpcodeList()
     /*0x2B6*/  StoreOpcode(SMSG_SCRIPT_MESSAGE,               "SMSG_SCRIPT_MESSAGE",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2B7*/  StoreOpcode(SMSG_DUEL_COUNTDOWN,               "SMSG_DUEL_COUNTDOWN",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2B8*/  StoreOpcode(SMSG_AREA_TRIGGER_MESSAGE,         "SMSG_AREA_TRIGGER_MESSAGE",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2B9*/  StoreOpcode(CMSG_TOGGLE_HELM,                  "CMSG_TOGGLE_HELM",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleShowingHelmOpcode);
-    /*0x2BA*/  StoreOpcode(CMSG_TOGGLE_CLOAK,                 "CMSG_TOGGLE_CLOAK",                STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleShowingCloakOpcode);
+    /*0x2B9*/  StoreOpcode(CMSG_TOGGLE_HELM,                  "CMSG_TOGGLE_HELM",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleShowingHelmOpcode);
+    /*0x2BA*/  StoreOpcode(CMSG_TOGGLE_CLOAK,                 "CMSG_TOGGLE_CLOAK",                STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleShowingCloakOpcode);
     /*0x2BB*/  StoreOpcode(SMSG_MEETINGSTONE_JOINFAILED,      "SMSG_MEETINGSTONE_JOINFAILED",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2BC*/  StoreOpcode(SMSG_PLAYER_SKINNED,               "SMSG_PLAYER_SKINNED",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2BD*/  StoreOpcode(SMSG_DURABILITY_DAMAGE_DEATH,      "SMSG_DURABILITY_DAMAGE_DEATH",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2BE*/  StoreOpcode(CMSG_SET_EXPLORATION,              "CMSG_SET_EXPLORATION",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x2BF*/  StoreOpcode(CMSG_SET_ACTIONBAR_TOGGLES,        "CMSG_SET_ACTIONBAR_TOGGLES",       STATUS_AUTHED,    PROCESS_THREADUNSAFE, &WorldSession::HandleSetActionBarTogglesOpcode);
+    /*0x2BF*/  StoreOpcode(CMSG_SET_ACTIONBAR_TOGGLES,        "CMSG_SET_ACTIONBAR_TOGGLES",       STATUS_AUTHED,    PROCESS_THREADSAFE,   &WorldSession::HandleSetActionBarTogglesOpcode);
     /*0x2C0*/  StoreOpcode(UMSG_DELETE_GUILD_CHARTER,         "UMSG_DELETE_GUILD_CHARTER",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x2C1*/  StoreOpcode(MSG_PETITION_RENAME,               "MSG_PETITION_RENAME",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetitionRenameOpcode);
     /*0x2C2*/  StoreOpcode(SMSG_INIT_WORLD_STATES,            "SMSG_INIT_WORLD_STATES",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2C3*/  StoreOpcode(SMSG_UPDATE_WORLD_STATE,           "SMSG_UPDATE_WORLD_STATE",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2C4*/  StoreOpcode(CMSG_ITEM_NAME_QUERY,              "CMSG_ITEM_NAME_QUERY",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleItemNameQueryOpcode);
+    /*0x2C4*/  StoreOpcode(CMSG_ITEM_NAME_QUERY,              "CMSG_ITEM_NAME_QUERY",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleItemNameQueryOpcode);
     /*0x2C5*/  StoreOpcode(SMSG_ITEM_NAME_QUERY_RESPONSE,     "SMSG_ITEM_NAME_QUERY_RESPONSE",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2C6*/  StoreOpcode(SMSG_PET_ACTION_FEEDBACK,          "SMSG_PET_ACTION_FEEDBACK",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2C7*/  StoreOpcode(CMSG_CHAR_RENAME,                  "CMSG_CHAR_RENAME",                 STATUS_AUTHED,    PROCESS_THREADUNSAFE, &WorldSession::HandleCharRenameOpcode);
@@ -794,7 +810,7 @@ void Opcodes::BuildOpcodeList()
     /*0x2E7*/  StoreOpcode(CMSG_WARDEN_DATA,                  "CMSG_WARDEN_DATA",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleWardenDataOpcode);
     /*0x2E8*/  StoreOpcode(SMSG_GROUP_JOINED_BATTLEGROUND,    "SMSG_GROUP_JOINED_BATTLEGROUND",   STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2E9*/  StoreOpcode(MSG_BATTLEGROUND_PLAYER_POSITIONS, "MSG_BATTLEGROUND_PLAYER_POSITIONS", STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleBattleGroundPlayerPositionsOpcode);
-    /*0x2EA*/  StoreOpcode(CMSG_PET_STOP_ATTACK,              "CMSG_PET_STOP_ATTACK",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetStopAttack);
+    /*0x2EA*/  StoreOpcode(CMSG_PET_STOP_ATTACK,              "CMSG_PET_STOP_ATTACK",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePetStopAttack);
     /*0x2EB*/  StoreOpcode(SMSG_BINDER_CONFIRM,               "SMSG_BINDER_CONFIRM",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2EC*/  StoreOpcode(SMSG_BATTLEGROUND_PLAYER_JOINED,   "SMSG_BATTLEGROUND_PLAYER_JOINED",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2ED*/  StoreOpcode(SMSG_BATTLEGROUND_PLAYER_LEFT,     "SMSG_BATTLEGROUND_PLAYER_LEFT",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -803,7 +819,7 @@ void Opcodes::BuildOpcodeList()
     /*0x2F0*/  StoreOpcode(CMSG_PET_UNLEARN,                  "CMSG_PET_UNLEARN",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetUnlearnOpcode);
     /*0x2F1*/  StoreOpcode(SMSG_PET_UNLEARN_CONFIRM,          "SMSG_PET_UNLEARN_CONFIRM",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2F2*/  StoreOpcode(SMSG_PARTY_MEMBER_STATS_FULL,      "SMSG_PARTY_MEMBER_STATS_FULL",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2F3*/  StoreOpcode(CMSG_PET_SPELL_AUTOCAST,           "CMSG_PET_SPELL_AUTOCAST",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetSpellAutocastOpcode);
+    /*0x2F3*/  StoreOpcode(CMSG_PET_SPELL_AUTOCAST,           "CMSG_PET_SPELL_AUTOCAST",          STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandlePetSpellAutocastOpcode);
     /*0x2F4*/  StoreOpcode(SMSG_WEATHER,                      "SMSG_WEATHER",                     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2F5*/  StoreOpcode(SMSG_PLAY_TIME_WARNING,            "SMSG_PLAY_TIME_WARNING",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2F6*/  StoreOpcode(SMSG_MINIGAME_SETUP,               "SMSG_MINIGAME_SETUP",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -839,8 +855,8 @@ void Opcodes::BuildOpcodeList()
     /*0x314*/  StoreOpcode(SMSG_GAMETIMEBIAS_SET,             "SMSG_GAMETIMEBIAS_SET",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x315*/  StoreOpcode(CMSG_DEBUG_ACTIONS_START,          "CMSG_DEBUG_ACTIONS_START",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x316*/  StoreOpcode(CMSG_DEBUG_ACTIONS_STOP,           "CMSG_DEBUG_ACTIONS_STOP",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x317*/  StoreOpcode(CMSG_SET_FACTION_INACTIVE,         "CMSG_SET_FACTION_INACTIVE",        STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetFactionInactiveOpcode);
-    /*0x318*/  StoreOpcode(CMSG_SET_WATCHED_FACTION,          "CMSG_SET_WATCHED_FACTION",         STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetWatchedFactionOpcode);
+    /*0x317*/  StoreOpcode(CMSG_SET_FACTION_INACTIVE,         "CMSG_SET_FACTION_INACTIVE",        STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSetFactionInactiveOpcode);
+    /*0x318*/  StoreOpcode(CMSG_SET_WATCHED_FACTION,          "CMSG_SET_WATCHED_FACTION",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleSetWatchedFactionOpcode);
     /*0x319*/  StoreOpcode(MSG_MOVE_TIME_SKIPPED,             "MSG_MOVE_TIME_SKIPPED",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x31A*/  StoreOpcode(SMSG_SPLINE_MOVE_ROOT,             "SMSG_SPLINE_MOVE_ROOT",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x31B*/  StoreOpcode(CMSG_SET_EXPLORATION_ALL,          "CMSG_SET_EXPLORATION_ALL",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -882,8 +898,8 @@ void Opcodes::BuildOpcodeList()
     /*0x342*/  StoreOpcode(MSG_MOVE_STOP_SWIM_CHEAT,          "MSG_MOVE_STOP_SWIM_CHEAT",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
 
     // [-ZERO] Last existed in 1.12.1 opcode, maybe some renumbering from other side
-    /*0x375*/  StoreOpcode(CMSG_CANCEL_MOUNT_AURA,            "CMSG_CANCEL_MOUNT_AURA",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelMountAuraOpcode);
-    /*0x379*/  StoreOpcode(CMSG_CANCEL_TEMP_ENCHANTMENT,      "CMSG_CANCEL_TEMP_ENCHANTMENT",     STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelTempEnchantmentOpcode);
+    /*0x375*/  StoreOpcode(CMSG_CANCEL_MOUNT_AURA,            "CMSG_CANCEL_MOUNT_AURA",           STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelMountAuraOpcode);
+    /*0x379*/  StoreOpcode(CMSG_CANCEL_TEMP_ENCHANTMENT,      "CMSG_CANCEL_TEMP_ENCHANTMENT",     STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelTempEnchantmentOpcode);
     /*0x389*/  StoreOpcode(CMSG_SET_TAXI_BENCHMARK_MODE,      "CMSG_SET_TAXI_BENCHMARK_MODE",     STATUS_AUTHED,    PROCESS_THREADUNSAFE, &WorldSession::HandleSetTaxiBenchmarkOpcode);
     /*0x38D*/  StoreOpcode(CMSG_MOVE_CHNG_TRANSPORT,          "CMSG_MOVE_CHNG_TRANSPORT",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
     /*0x38E*/  StoreOpcode(MSG_PARTY_ASSIGNMENT,              "MSG_PARTY_ASSIGNMENT",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePartyAssignmentOpcode);
@@ -940,10 +956,10 @@ void Opcodes::BuildOpcodeList()
     /*0x410*/  StoreOpcode(CMSG_GROUPACTION_THROTTLED,        "CMSG_GROUPACTION_THROTTLED",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x411*/  StoreOpcode(SMSG_OVERRIDE_LIGHT,               "SMSG_OVERRIDE_LIGHT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x412*/  StoreOpcode(SMSG_TOTEM_CREATED,                "SMSG_TOTEM_CREATED",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x413*/  StoreOpcode(CMSG_TOTEM_DESTROYED,              "CMSG_TOTEM_DESTROYED",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTotemDestroyed);
+    /*0x413*/  StoreOpcode(CMSG_TOTEM_DESTROYED,              "CMSG_TOTEM_DESTROYED",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleTotemDestroyed);
     /*0x414*/  StoreOpcode(CMSG_EXPIRE_RAID_INSTANCE,         "CMSG_EXPIRE_RAID_INSTANCE",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x415*/  StoreOpcode(CMSG_NO_SPELL_VARIANCE,            "CMSG_NO_SPELL_VARIANCE",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x416*/  StoreOpcode(CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY,  "CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY",   STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleQuestgiverStatusMultipleQuery);
+    /*0x416*/  StoreOpcode(CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY,  "CMSG_QUESTGIVER_STATUS_MULTIPLE_QUERY",   STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleQuestgiverStatusMultipleQuery);
     /*0x417*/  StoreOpcode(SMSG_QUESTGIVER_STATUS_MULTIPLE,   "SMSG_QUESTGIVER_STATUS_MULTIPLE",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x41A*/  StoreOpcode(CMSG_QUERY_SERVER_BUCK_DATA,       "CMSG_QUERY_SERVER_BUCK_DATA",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x41B*/  StoreOpcode(CMSG_CLEAR_SERVER_BUCK_DATA,       "CMSG_CLEAR_SERVER_BUCK_DATA",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -948,7 +948,7 @@ enum OpcodesList
 #define NUM_MSG_TYPES 0x424
 
 /// Player state
-enum SessionStatus
+enum SessionStatus : uint8
 {
     STATUS_AUTHED = 0,                                      ///< Player authenticated (_player==nullptr, m_playerRecentlyLogout = false or will be reset before handler call)
     STATUS_LOGGEDIN,                                        ///< Player in game (_player!=nullptr, inWorld())
@@ -958,7 +958,16 @@ enum SessionStatus
     STATUS_UNHANDLED                                        ///< We don' handle this opcode yet
 };
 
-enum PacketProcessing
+/// Session state bits, an opcode handler runs when its allowed states intersect the current ones
+enum SessionStateMask : uint8
+{
+    SESSION_STATE_MASK_AUTHED           = 0x01,             ///< session passed the login queue
+    SESSION_STATE_MASK_IN_WORLD         = 0x02,             ///< _player!=nullptr, inWorld()
+    SESSION_STATE_MASK_TRANSFER         = 0x04,             ///< _player!=nullptr, !inWorld()
+    SESSION_STATE_MASK_RECENTLY_LOGOUT  = 0x08,             ///< _player==nullptr, m_playerRecentlyLogout
+};
+
+enum PacketProcessing : uint8
 {
     PROCESS_INPLACE = 0,                                    // process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   // packet is not thread-safe - process it in World::UpdateSessions()
@@ -967,16 +976,15 @@ enum PacketProcessing
 
 class WorldPacket;
 
+// hot dispatch data only, opcode names are kept in a separate table
 struct OpcodeHandler
 {
-    char const* name;
+    void (WorldSession::*handler)(WorldPacket& recvPacket);
     SessionStatus status;
     PacketProcessing packetProcessing;
-    void (WorldSession::*handler)(WorldPacket& recvPacket);
+    uint8 allowedStates;                                    // SessionStateMask bits derived from status
 };
 
-typedef std::map< uint16, OpcodeHandler> OpcodeMap;
-
 class Opcodes
 {
     public:
@@ -986,35 +994,41 @@ class Opcodes
         void BuildOpcodeList();
         void StoreOpcode(uint16 Opcode, char const* name, SessionStatus status, PacketProcessing process, void (WorldSession::*handler)(WorldPacket& recvPacket))
         {
-            OpcodeHandler& ref = mOpcodeMap[Opcode];
-            ref.name = name;
+            OpcodeHandler& ref = mOpcodes[Opcode];
+            ref.handler = handler;
             ref.status = status;
             ref.packetProcessing = process;
-            ref.handler = handler;
+            ref.allowedStates = GetAllowedStates(status);
+            mOpcodeNames[Opcode] = name;
         }
 
         /// Lookup opcode
         inline OpcodeHandler const* LookupOpcode(uint16 id) const
         {
-            OpcodeMap::const_iterator itr = mOpcodeMap.find(id);
-            if (itr != mOpcodeMap.end())
-                return &itr->second;
+            if (id < NUM_MSG_TYPES && mOpcodeNames[id])
+                return &mOpcodes[id];
             return nullptr;
         }
 
-        /// compatible with other mangos branches access
-
+        /// compatible with other mangos branches access, unknown opcodes get emptyHandler
         inline OpcodeHandler const& operator[](uint16 id) const
         {
-            OpcodeMap::const_iterator itr = mOpcodeMap.find(id);
-            if (itr != mOpcodeMap.end())
-                return itr->second;
-            return emptyHandler;
+            return id < NUM_MSG_TYPES ? mOpcodes[id] : emptyHandler;
+        }
+
+        /// Opcode name for logging, nullptr for unknown opcodes
+        inline char const* GetOpcodeName(uint16 id) const
+        {
+            return id < NUM_MSG_TYPES ? mOpcodeNames[id] : nullptr;
         }
 
+        static uint8 GetAllowedStates(SessionStatus status);
+
         static OpcodeHandler const emptyHandler;
 
-        OpcodeMap mOpcodeMap;
+    private:
+        OpcodeHandler mOpcodes[NUM_MSG_TYPES];
+        char const* mOpcodeNames[NUM_MSG_TYPES];
 };
 
 #define opcodeTable MaNGOS::Singleton<Opcodes>::Instance()
@@ -1022,8 +1036,8 @@ class Opcodes
 /// Lookup opcode name for human understandable logging
 inline char const* LookupOpcodeName(uint16 id)
 {
-    if (OpcodeHandler const* op = opcodeTable.LookupOpcode(id))
-        return op->name;
+    if (char const* name = opcodeTable.GetOpcodeName(id))
+        return name;
     return "Received unknown opcode, it's more than max!";
 }
 #endif
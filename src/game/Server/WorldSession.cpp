@@ -25,6 +25,7 @@
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "Server/Opcodes.h"
+#include "Server/OpcodeProfiler.h"
 #include "WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Entities/Player.h"
@@ -41,7 +42,9 @@
 
 #include <mutex>
 #include <deque>
+#include <iterator>
 #include <memory>
+#include <chrono>
 #include <cstdarg>
 #include <iostream>
 
@@ -97,7 +100,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, time_
     m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(true),
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
     m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_sessionState(WORLD_SESSION_STATE_CREATED),
-    m_requestSocket(nullptr) {}
+    m_requestSocket(nullptr), m_packetCostDebt(0) {}
 
 /// WorldSession destructor
 WorldSession::~WorldSession()
@@ -189,41 +192,7 @@ void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= fal
         return;
     }
 
-#ifdef MANGOS_DEBUG
-
-    // Code for network use statistic
-    static uint64 sendPacketCount = 0;
-    static uint64 sendPacketBytes = 0;
-
-    static time_t firstTime = time(nullptr);
-    static time_t lastTime = firstTime;                     // next 60 secs start time
-
-    static uint64 sendLastPacketCount = 0;
-    static uint64 sendLastPacketBytes = 0;
-
-    time_t cur_time = time(nullptr);
-
-    if ((cur_time - lastTime) < 60)
-    {
-        sendPacketCount += 1;
-        sendPacketBytes += packet.size();
-
-        sendLastPacketCount += 1;
-        sendLastPacketBytes += packet.size();
-    }
-    else
-    {
-        uint64 minTime = uint64(cur_time - lastTime);
-        uint64 fullTime = uint64(lastTime - firstTime);
-        DETAIL_LOG("Send all time packets count: " UI64FMTD " bytes: " UI64FMTD " avr.count/sec: %f avr.bytes/sec: %f time: %u", sendPacketCount, sendPacketBytes, float(sendPacketCount) / fullTime, float(sendPacketBytes) / fullTime, uint32(fullTime));
-        DETAIL_LOG("Send last min packets count: " UI64FMTD " bytes: " UI64FMTD " avr.count/sec: %f avr.bytes/sec: %f", sendLastPacketCount, sendLastPacketBytes, float(sendLastPacketCount) / minTime, float(sendLastPacketBytes) / minTime);
-
-        lastTime = cur_time;
-        sendLastPacketCount = 1;
-        sendLastPacketBytes = packet.wpos();               // wpos is real written size
-    }
-
-#endif                                                  // !MANGOS_DEBUG
+    sOpcodeProfiler.RecordSend(packet.GetOpcode(), packet.size());
 
     m_Socket->SendPacket(packet);
 }
@@ -265,107 +234,63 @@ bool WorldSession::Update(PacketFilter& updater)
         std::swap(recvQueueCopy, m_recvQueue);
     }
 
+    // every session gets the same packet budget per update, so a flooding client only delays its own packets;
+    // cost above the budget is carried as debt and reduces the budget of the next updates
+    uint32 const costBudget = sWorld.getConfig(CONFIG_UINT32_PACKET_BUDGET);
+    uint32 const timeBudget = sWorld.getConfig(CONFIG_UINT32_PACKET_TIME_BUDGET);
+    uint32 costLeft = costBudget;
+    if (costBudget)
+    {
+        uint32 paid = std::min(costBudget, m_packetCostDebt);
+        m_packetCostDebt -= paid;
+        costLeft -= paid;
+    }
+    auto const budgetStart = std::chrono::steady_clock::now();
+
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     while (m_Socket && !m_Socket->IsClosed() && !recvQueueCopy.empty())
     {
+        // keep arrival order: stop at the first packet which belongs to the other update context
+        if (!updater.Process(*recvQueueCopy.front()))
+            break;
+
+        // budget spent, leave the remaining packets for the next update
+        if (costBudget && !costLeft)
+            break;
+
+        if (timeBudget && std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - budgetStart).count() >= timeBudget)
+            break;
+
         auto const packet = std::move(recvQueueCopy.front());
         recvQueueCopy.pop_front();
 
+        if (costBudget)
+        {
+            uint32 cost = sWorld.GetPacketCost(packet->GetOpcode());
+            if (cost > costLeft)
+            {
+                m_packetCostDebt += cost - costLeft;
+                costLeft = 0;
+            }
+            else
+                costLeft -= cost;
+        }
+
         /*#if 1
         sLog.outError( "MOEP: %s (0x%.4X)",
                         packet->GetOpcodeName(),
                         packet->GetOpcode());
         #endif*/
 
-        OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
-        try
-        {
-            switch (opHandle.status)
-            {
-                case STATUS_LOGGEDIN:
-                    if (!_player)
-                    {
-                        // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
-                        if (!m_playerRecentlyLogout)
-                            LogUnexpectedOpcode(*packet, "the player has not logged in yet");
-                    }
-                    else if (_player->IsInWorld())
-                        ExecuteOpcode(opHandle, *packet);
-
-                    // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
-
-#ifdef BUILD_PLAYERBOT
-                    if (_player && _player->GetPlayerbotMgr())
-                        _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(*packet);
-#endif
-                    break;
-                case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT:
-                    if (!_player && !m_playerRecentlyLogout)
-                    {
-                        LogUnexpectedOpcode(*packet, "the player has not logged in yet and not recently logout");
-                    }
-                    else
-                        // not expected _player or must checked in packet hanlder
-                        ExecuteOpcode(opHandle, *packet);
-                    break;
-                case STATUS_TRANSFER:
-                    if (!_player)
-                        LogUnexpectedOpcode(*packet, "the player has not logged in yet");
-                    else if (_player->IsInWorld())
-                        LogUnexpectedOpcode(*packet, "the player is still in world");
-                    else
-                        ExecuteOpcode(opHandle, *packet);
-                    break;
-                case STATUS_AUTHED:
-                    // prevent cheating with skip queue wait
-                    if (m_inQueue)
-                    {
-                        LogUnexpectedOpcode(*packet, "the player not pass queue yet");
-                        break;
-                    }
-
-                    // single from authed time opcodes send in to after logout time
-                    // and before other STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT opcodes.
-                    m_playerRecentlyLogout = false;
-
-                    ExecuteOpcode(opHandle, *packet);
-                    break;
-                case STATUS_NEVER:
-                    sLog.outError("SESSION: received not allowed opcode %s (0x%.4X)",
-                                  packet->GetOpcodeName(),
-                                  packet->GetOpcode());
-                    break;
-                case STATUS_UNHANDLED:
-                    DEBUG_LOG("SESSION: received not handled opcode %s (0x%.4X)",
-                              packet->GetOpcodeName(),
-                              packet->GetOpcode());
-                    break;
-                default:
-                    sLog.outError("SESSION: received wrong-status-req opcode %s (0x%.4X)",
-                                  packet->GetOpcodeName(),
-                                  packet->GetOpcode());
-                    break;
-            }
-        }
-        catch (ByteBufferException&)
-        {
-            sLog.outError("WorldSession::Update ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i.",
-                          packet->GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
-            if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
-            {
-                DEBUG_LOG("Dumping error causing packet:");
-                packet->hexlike();
-            }
-
-            if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
-            {
-                DETAIL_LOG("Disconnecting session [account id %u / address %s] for badly formatted packet.",
-                           GetAccountId(), GetRemoteAddress().c_str());
+        DispatchPacket(*packet);
+    }
 
-                KickPlayer();
-            }
-        }
+    // put back packets left for Map::Update() or World::UpdateSessions() in front of newly received ones
+    if (!recvQueueCopy.empty() && m_Socket && !m_Socket->IsClosed())
+    {
+        std::lock_guard<std::mutex> guard(m_recvQueueLock);
+        m_recvQueue.insert(m_recvQueue.begin(), std::make_move_iterator(recvQueueCopy.begin()), std::make_move_iterator(recvQueueCopy.end()));
     }
 
 #ifdef BUILD_PLAYERBOT
@@ -385,8 +310,7 @@ bool WorldSession::Update(PacketFilter& updater)
                 auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
                 pBotWorldSession->m_recvQueue.pop_front();
 
-                OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
-                pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
+                pBotWorldSession->DispatchPacket(*botpacket);
             }
         }
         GetPlayer()->GetPlayerbotMgr()->RemoveBots();
@@ -921,6 +845,100 @@ void WorldSession::SendTransferAborted(uint32 mapid, uint8 reason, uint8 arg) co
     SendPacket(data);
 }
 
+uint8 WorldSession::GetStateMask() const
+{
+    uint8 mask = m_inQueue ? 0 : SESSION_STATE_MASK_AUTHED;
+    if (_player)
+        mask |= _player->IsInWorld() ? SESSION_STATE_MASK_IN_WORLD : SESSION_STATE_MASK_TRANSFER;
+    else if (m_playerRecentlyLogout)
+        mask |= SESSION_STATE_MASK_RECENTLY_LOGOUT;
+    return mask;
+}
+
+/// Check the opcode status against the session state and call the handler, used for client and bot packets
+void WorldSession::DispatchPacket(WorldPacket& packet)
+{
+    OpcodeHandler const& opHandle = opcodeTable[packet.GetOpcode()];
+    try
+    {
+        if (opHandle.allowedStates & GetStateMask())
+        {
+            // single from authed time opcodes send in to after logout time
+            // and before other STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT opcodes.
+            m_playerRecentlyLogout = m_playerRecentlyLogout && opHandle.status != STATUS_AUTHED;
+
+            ExecuteOpcode(opHandle, packet);
+        }
+        else
+            LogRejectedOpcode(opHandle, packet);
+
+#ifdef BUILD_PLAYERBOT
+        if (opHandle.status == STATUS_LOGGEDIN && _player && _player->GetPlayerbotMgr())
+            _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(packet);
+#endif
+    }
+    catch (ByteBufferException&)
+    {
+        sLog.outError("WorldSession::Update ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i.",
+                      packet.GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
+        if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+        {
+            DEBUG_LOG("Dumping error causing packet:");
+            packet.hexlike();
+        }
+
+        if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+        {
+            DETAIL_LOG("Disconnecting session [account id %u / address %s] for badly formatted packet.",
+                       GetAccountId(), GetRemoteAddress().c_str());
+
+            KickPlayer();
+        }
+    }
+}
+
+/// Explain why an opcode was not handled in the current session state
+void WorldSession::LogRejectedOpcode(OpcodeHandler const& opHandle, WorldPacket const& packet) const
+{
+    switch (opHandle.status)
+    {
+        case STATUS_LOGGEDIN:
+            // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
+            // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
+            if (!_player && !m_playerRecentlyLogout)
+                LogUnexpectedOpcode(packet, "the player has not logged in yet");
+            break;
+        case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT:
+            LogUnexpectedOpcode(packet, "the player has not logged in yet and not recently logout");
+            break;
+        case STATUS_TRANSFER:
+            if (!_player)
+                LogUnexpectedOpcode(packet, "the player has not logged in yet");
+            else
+                LogUnexpectedOpcode(packet, "the player is still in world");
+            break;
+        case STATUS_AUTHED:
+            // prevent cheating with skip queue wait
+            LogUnexpectedOpcode(packet, "the player not pass queue yet");
+            break;
+        case STATUS_NEVER:
+            sLog.outError("SESSION: received not allowed opcode %s (0x%.4X)",
+                          packet.GetOpcodeName(),
+                          packet.GetOpcode());
+            break;
+        case STATUS_UNHANDLED:
+            DEBUG_LOG("SESSION: received not handled opcode %s (0x%.4X)",
+                      packet.GetOpcodeName(),
+                      packet.GetOpcode());
+            break;
+        default:
+            sLog.outError("SESSION: received wrong-status-req opcode %s (0x%.4X)",
+                          packet.GetOpcodeName(),
+                          packet.GetOpcode());
+            break;
+    }
+}
+
 void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet)
 {
     // need prevent do internal far teleports in handlers because some handlers do lot steps
@@ -928,7 +946,9 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    auto const handlerStart = std::chrono::steady_clock::now();
     (this->*opHandle.handler)(packet);
+    sOpcodeProfiler.RecordHandler(packet.GetOpcode(), std::chrono::steady_clock::now() - handlerStart);
 
     if (_player)
     {
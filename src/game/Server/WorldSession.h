@@ -606,6 +606,7 @@ class WorldSession
         void SendWrongFactionNotice() const;
         void SendChatRestrictedNotice() const;
         void HandleMessagechatOpcode(WorldPacket& recvPacket);
+        void ProcessMessagechat(WorldPacket& recvPacket);
         void HandleTextEmoteOpcode(WorldPacket& recvPacket);
         void HandleChatIgnoredOpcode(WorldPacket& recvPacket);
 
@@ -703,6 +704,9 @@ class WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
+        uint8 GetStateMask() const;
+        void DispatchPacket(WorldPacket& packet);
+        void LogRejectedOpcode(OpcodeHandler const& opHandle, WorldPacket const& packet) const;
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
 
         // logging helper
@@ -738,6 +742,8 @@ class WorldSession
 
         bool m_initialZoneUpdated = false;
 
+        uint32 m_packetCostDebt;                            // budget overdrawn by expensive packets, paid back from the next updates
+
         std::mutex m_recvQueueLock;
         std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
 
@@ -80,6 +80,8 @@ bool PlayerSocial::AddToSocialList(ObjectGuid friend_guid, bool ignore)
         fi.Flags |= flag;
         m_playerSocialMap[friend_guid.GetCounter()] = fi;
     }
+
+    sSocialMgr.AddToReverseIndex(friend_guid.GetCounter(), m_playerLowGuid, flag);
     return true;
 }
 
@@ -93,6 +95,8 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid friend_guid, bool ignore)
     if (ignore)
         flag = SOCIAL_FLAG_IGNORED;
 
+    sSocialMgr.RemoveFromReverseIndex(friend_guid.GetCounter(), m_playerLowGuid, itr->second.Flags & flag);
+
     itr->second.Flags &= ~flag;
     if (itr->second.Flags == 0)
     {
@@ -183,6 +187,46 @@ SocialMgr::~SocialMgr()
 {
 }
 
+void SocialMgr::RemovePlayerSocial(uint32 guid)
+{
+    SocialMap::iterator itr = m_socialMap.find(guid);
+    if (itr == m_socialMap.end())
+        return;
+
+    for (PlayerSocialMap::const_iterator itr2 = itr->second.m_playerSocialMap.begin(); itr2 != itr->second.m_playerSocialMap.end(); ++itr2)
+        RemoveFromReverseIndex(itr2->first, guid, itr2->second.Flags);
+
+    m_socialMap.erase(itr);
+}
+
+void SocialMgr::AddToReverseIndex(uint32 lowguid, uint32 listerLowGuid, uint32 flags)
+{
+    if (flags & SOCIAL_FLAG_FRIEND)
+        m_friendOf[lowguid].insert(listerLowGuid);
+    if (flags & SOCIAL_FLAG_IGNORED)
+        m_ignoredBy[lowguid].insert(listerLowGuid);
+}
+
+void SocialMgr::RemoveFromReverseIndex(uint32 lowguid, uint32 listerLowGuid, uint32 flags)
+{
+    SocialReverseMap* indexes[] = { &m_friendOf, &m_ignoredBy };
+    uint32 const indexFlags[] = { SOCIAL_FLAG_FRIEND, SOCIAL_FLAG_IGNORED };
+
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        if (!(flags & indexFlags[i]))
+            continue;
+
+        SocialReverseMap::iterator itr = indexes[i]->find(lowguid);
+        if (itr == indexes[i]->end())
+            continue;
+
+        itr->second.erase(listerLowGuid);
+        if (itr->second.empty())
+            indexes[i]->erase(itr);
+    }
+}
+
 void SocialMgr::GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo& friendInfo) const
 {
     if (!player)
@@ -271,28 +315,30 @@ void SocialMgr::BroadcastToFriendListers(Player* player, WorldPacket const& pack
     AccountTypes gmLevelInWhoList = AccountTypes(sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST));
     bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
 
-    for (SocialMap::const_iterator itr = m_socialMap.begin(); itr != m_socialMap.end(); ++itr)
+    SocialListerSet const* listers = GetFriendOf(guid);
+    if (!listers)
+        return;
+
+    for (uint32 listerLowGuid : *listers)
     {
-        PlayerSocialMap::const_iterator itr2 = itr->second.m_playerSocialMap.find(guid);
-        if (itr2 != itr->second.m_playerSocialMap.end() && (itr2->second.Flags & SOCIAL_FLAG_FRIEND))
+        Player* pFriend = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, listerLowGuid));
+
+        // PLAYER see his team only and PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
+        // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
+        if (pFriend && pFriend->IsInWorld() &&
+                (pFriend->GetSession()->GetSecurity() > SEC_PLAYER ||
+                 ((pFriend->GetTeam() == team || allowTwoSideWhoList) && security <= gmLevelInWhoList)) &&
+                player->IsVisibleGloballyFor(pFriend))
         {
-            Player* pFriend = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-
-            // PLAYER see his team only and PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
-            // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
-            if (pFriend && pFriend->IsInWorld() &&
-                    (pFriend->GetSession()->GetSecurity() > SEC_PLAYER ||
-                     ((pFriend->GetTeam() == team || allowTwoSideWhoList) && security <= gmLevelInWhoList)) &&
-                    player->IsVisibleGloballyFor(pFriend))
-            {
-                pFriend->GetSession()->SendPacket(packet);
-            }
+            pFriend->GetSession()->SendPacket(packet);
         }
     }
 }
 
 PlayerSocial* SocialMgr::LoadFromDB(QueryResult* result, ObjectGuid guid)
 {
+    RemovePlayerSocial(guid.GetCounter());                  // drop stale list and its index entries if any
+
     PlayerSocial* social = &m_socialMap[guid.GetCounter()];
     social->SetPlayerGuid(guid);
 
@@ -315,6 +361,7 @@ PlayerSocial* SocialMgr::LoadFromDB(QueryResult* result, ObjectGuid guid)
             continue;
 
         social->m_playerSocialMap[friend_guid] = FriendInfo(flags);
+        AddToReverseIndex(friend_guid, guid.GetCounter(), flags);
 
         if (flags & SOCIAL_FLAG_IGNORED)
             ++ignoreCounter;
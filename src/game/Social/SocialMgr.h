@@ -68,8 +68,10 @@ struct FriendInfo
     {}
 };
 
-typedef std::map<uint32, FriendInfo> PlayerSocialMap;
+typedef std::unordered_map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+typedef std::unordered_set<uint32> SocialListerSet;                     // low guids of loaded players
+typedef std::unordered_map<uint32, SocialListerSet> SocialReverseMap;   // player low guid -> players having him on their list
 
 /// Results of friend related commands
 enum FriendsResult
@@ -135,7 +137,12 @@ class SocialMgr
         SocialMgr();
         ~SocialMgr();
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
+
+        // players (with loaded social list) ignoring the player, nullptr if none
+        SocialListerSet const* GetIgnoredBy(uint32 lowguid) const { return GetListers(m_ignoredBy, lowguid); }
+        // players (with loaded social list) having the player as friend, nullptr if none
+        SocialListerSet const* GetFriendOf(uint32 lowguid) const { return GetListers(m_friendOf, lowguid); }
 
         void GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo& friendInfo) const;
         // Packet management
@@ -145,7 +152,21 @@ class SocialMgr
         // Loading
         PlayerSocial* LoadFromDB(QueryResult* result, ObjectGuid guid);
     private:
+        friend class PlayerSocial;
+
+        static SocialListerSet const* GetListers(SocialReverseMap const& index, uint32 lowguid)
+        {
+            SocialReverseMap::const_iterator itr = index.find(lowguid);
+            return itr != index.end() ? &itr->second : nullptr;
+        }
+
+        // keep reverse indexes in sync with a flag change of listerLowGuid's entry for lowguid
+        void AddToReverseIndex(uint32 lowguid, uint32 listerLowGuid, uint32 flags);
+        void RemoveFromReverseIndex(uint32 lowguid, uint32 listerLowGuid, uint32 flags);
+
         SocialMap m_socialMap;
+        SocialReverseMap m_ignoredBy;                       // reverse index of loaded ignore lists
+        SocialReverseMap m_friendOf;                        // reverse index of loaded friend lists
 };
 
 #define sSocialMgr MaNGOS::Singleton<SocialMgr>::Instance()
@@ -27,6 +27,7 @@
 #include "SystemConfig.h"
 #include "Log.h"
 #include "Server/Opcodes.h"
+#include "Server/OpcodeProfiler.h"
 #include "Server/WorldSession.h"
 #include "WorldPacket.h"
 #include "Entities/Player.h"
@@ -97,7 +98,8 @@ TimePoint World::m_currentTime = TimePoint();
 uint32 World::m_currentDiff = 0;
 
 /// World constructor
-World::World(): mail_timer(0), mail_timer_expires(0), m_NextWeeklyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES)
+World::World(): mail_timer(0), mail_timer_expires(0), m_NextWeeklyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES),
+    m_loginCount(0), m_loginQueryTime(0), m_loginLoadTime(0)
 {
     m_playerLimit = 0;
     m_allowMovement = true;
@@ -470,6 +472,9 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetGridCleanUpDelay(getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN));
 
+    setConfig(CONFIG_UINT32_GRID_UNLOAD_DELETE_PER_UPDATE, "GridUnload.DeletePerUpdate", 200);
+    setConfig(CONFIG_UINT32_GRID_UNLOAD_TILES_PER_UPDATE, "GridUnload.TilesPerUpdate", 4);
+
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
@@ -542,6 +547,18 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR, "Instance.ResetTimeHour", 4);
     setConfig(CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,    "Instance.UnloadDelay", 30 * MINUTE * IN_MILLISECONDS);
+    setConfigMinMax(CONFIG_UINT32_INSTANCE_PREWARM_COUNT, "Instance.Prewarm.Count", 1, 0, 10);
+
+    m_configPrewarmMapIds.clear();
+    std::string prewarmMaps = sConfig.GetStringDefault("Instance.Prewarm.Maps");
+    if (!prewarmMaps.empty())
+    {
+        unsigned int pos = 0;
+        unsigned int id;
+        VMAP::VMapFactory::chompAndTrim(prewarmMaps);
+        while (VMAP::VMapFactory::getNextId(prewarmMaps, pos, id))
+            m_configPrewarmMapIds.insert(id);
+    }
 
     setConfigMinMax(CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL, "MaxPrimaryTradeSkill", 2, 0, 10);
 
@@ -577,6 +594,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
 
     setConfigMin(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK, "MassMailer.SendPerTick", 10, 1);
+    setConfigMin(CONFIG_UINT32_MAIL_EXPIRE_PER_TICK, "Mail.ExpirePerTick", 50, 1);
 
     setConfig(CONFIG_UINT32_UPTIME_UPDATE, "UpdateUptimeInterval", 10);
     if (reload)
@@ -611,6 +629,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
+    setConfig(CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_INTERVAL, "SaveRespawnTime.BatchInterval", 5 * IN_MILLISECONDS);
+    setConfigMin(CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_SIZE, "SaveRespawnTime.BatchSize", 200, 1);
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
     setConfig(CONFIG_BOOL_ALWAYS_MAX_SKILL_FOR_LEVEL, "AlwaysMaxSkillForLevel", false);
@@ -620,6 +640,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHATFLOOD_MUTE_TIME,     "ChatFlood.MuteTime", 10);
 
     setConfig(CONFIG_BOOL_EVENT_ANNOUNCE, "Event.Announce", false);
+    setConfig(CONFIG_UINT32_GAME_EVENT_SPAWNS_PER_UPDATE, "GameEvent.SpawnsPerUpdate", 100);
 
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_ASSISTANCE_DELAY, "CreatureFamilyAssistanceDelay", 1500);
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_FLEE_DELAY,       "CreatureFamilyFleeDelay",       10000);
@@ -648,6 +669,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW,                     "Corpse.EmptyLootShow",                  true);
     setConfig(CONFIG_BOOL_CORPSE_ALLOW_ALL_ITEMS_SHOW_IN_MASTER_LOOT, "Corpse.AllowAllItemsShowInMasterLoot", false);
+    setConfig(CONFIG_BOOL_LOOT_DEFERRED_GENERATION,                   "Loot.DeferredGeneration",               false);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_NORMAL,                      "Corpse.Decay.NORMAL",                    300);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_RARE,                        "Corpse.Decay.RARE",                      900);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_ELITE,                       "Corpse.Decay.ELITE",                     600);
@@ -678,12 +700,41 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OUTDOORPVP_EP_ENABLED,                       "OutdoorPvp.EPEnabled", true);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_UINT32_PACKET_BUDGET, "Network.PacketBudget", 100);
+    setConfig(CONFIG_UINT32_PACKET_TIME_BUDGET, "Network.PacketTimeBudget", 5000);
+
+    m_configPacketCosts.assign(NUM_MSG_TYPES, 1);
+    std::string packetCosts = sConfig.GetStringDefault("Network.PacketCost", "CMSG_WHO:10 CMSG_AUCTION_LIST_ITEMS:10 CMSG_AUCTION_LIST_OWNER_ITEMS:5 "
+                              "CMSG_AUCTION_LIST_BIDDER_ITEMS:5 CMSG_GUILD_ROSTER:5 CMSG_GET_MAIL_LIST:5 CMSG_CHAR_ENUM:5");
+    for (auto const& token : StrSplit(packetCosts, " "))
+    {
+        Tokens pair = StrSplit(token, ":");
+        uint32 cost = pair.size() == 2 ? uint32(atoi(pair[1].c_str())) : 0;
+
+        uint16 opcode = 0;
+        for (; opcode < NUM_MSG_TYPES; ++opcode)
+        {
+            char const* name = opcodeTable.GetOpcodeName(opcode);
+            if (name && pair[0] == name)
+                break;
+        }
+
+        if (opcode >= NUM_MSG_TYPES || !cost)
+        {
+            sLog.outError("Network.PacketCost: invalid entry '%s', expected OPCODE_NAME:cost, skipped.", token.c_str());
+            continue;
+        }
+
+        m_configPacketCosts[opcode] = cost;
+    }
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
     setConfig(CONFIG_UINT32_INSTANT_LOGOUT, "InstantLogout", SEC_MODERATOR);
 
     setConfigMin(CONFIG_UINT32_GROUP_OFFLINE_LEADER_DELAY, "Group.OfflineLeaderDelay", 300, 0);
+    setConfig(CONFIG_UINT32_GROUP_STATS_UPDATE_INTERVAL, "Group.StatsUpdateInterval", 500);
+    setConfig(CONFIG_UINT32_GROUP_POSITION_UPDATE_INTERVAL, "Group.PositionUpdateInterval", 2000);
 
     setConfigMin(CONFIG_UINT32_GUILD_EVENT_LOG_COUNT, "Guild.EventLogRecordsCount", GUILD_EVENTLOG_MAX_RECORDS, GUILD_EVENTLOG_MAX_RECORDS);
 
@@ -1259,7 +1310,7 @@ void World::SetInitialWorldSettings()
 
 #ifdef BUILD_AHBOT
     // for AhBot
-    m_timers[WUPDATE_AHBOT].SetInterval(20 * IN_MILLISECONDS); // every 20 sec
+    m_timers[WUPDATE_AHBOT].SetInterval(AUCTIONHOUSEBOT_UPDATE_INTERVAL); // every 20 sec
 #endif
 
     // Update groups with offline leader after delay in seconds
@@ -1416,6 +1467,9 @@ void World::Update(uint32 diff)
     ///-Update mass mailer tasks if any
     sMassMailMgr.Update();
 
+    ///- Return or delete expired mails fetched by the last ReturnOrDeleteOldMails run
+    sObjectMgr.UpdateExpiredMails();
+
     /// Handle weekly quests reset time
     if (m_gameTime > m_NextWeeklyQuestReset)
         ResetWeeklyQuests();
@@ -1444,6 +1498,7 @@ void World::Update(uint32 diff)
         sAuctionHouseBot.Update();
         m_timers[WUPDATE_AHBOT].Reset();
     }
+    sAuctionHouseBot.UpdatePendingOrders(diff);
 #endif
 
     /// <li> Handle session updates
@@ -1462,7 +1517,13 @@ void World::Update(uint32 diff)
     auto preMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
+#ifdef BUILD_AHBOT
+    sAuctionHouseBot.StartPreparation();
+#endif
     sMapMgr.Update(diff);
+#ifdef BUILD_AHBOT
+    sAuctionHouseBot.FinishPreparation();
+#endif
     auto postMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     sBattleGroundMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
@@ -1511,6 +1572,10 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_METRICS].Reset();
 
         GeneratePacketMetrics();
+        sOpcodeProfiler.GenerateMetrics();
+        sLootMgr.GenerateMetrics();
+        sMapMgr.GenerateMetrics();
+        sMapPersistentStateMgr.GenerateMetrics();
     }
 
     /// </ul>
@@ -2406,6 +2471,13 @@ void World::IncrementOpcodeCounter(uint32 opcodeId)
     ++m_opcodeCounters[opcodeId];
 }
 
+void World::RecordPlayerLogin(uint64 queryTime, uint64 loadTime)
+{
+    m_loginQueryTime += queryTime;
+    m_loginLoadTime += loadTime;
+    ++m_loginCount;
+}
+
 void World::GeneratePacketMetrics()
 {
     for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
@@ -2413,7 +2485,7 @@ void World::GeneratePacketMetrics()
         if (m_opcodeCounters[i] == 0)
             continue;
 
-        metric::measurement meas("world.metrics.packets.received", { {"opcode", opcodeTable[i].name} });
+        metric::measurement meas("world.metrics.packets.received", { {"opcode", LookupOpcodeName(i)} });
         meas.add_field("count", std::to_string(static_cast<uint32>(m_opcodeCounters[i])));
 
         // Reset counter
@@ -2447,5 +2519,18 @@ void World::GeneratePacketMetrics()
     meas_players.add_field("mage", std::to_string(GetOnlineClassPlayers(CLASS_MAGE)));
     meas_players.add_field("warlock", std::to_string(GetOnlineClassPlayers(CLASS_WARLOCK)));
     meas_players.add_field("druid", std::to_string(GetOnlineClassPlayers(CLASS_DRUID)));
+
+    uint32 logins = m_loginCount.exchange(0);
+    uint64 loginQueryTime = m_loginQueryTime.exchange(0);
+    uint64 loginLoadTime = m_loginLoadTime.exchange(0);
+
+    metric::measurement meas_logins("world.metrics.logins");
+    meas_logins.add_field("count", std::to_string(logins));
+    meas_logins.add_field("per_second", std::to_string(float(logins) * IN_MILLISECONDS / m_timers[WUPDATE_METRICS].GetInterval()));
+    if (logins)
+    {
+        meas_logins.add_field("query_us", std::to_string(loginQueryTime / logins));
+        meas_logins.add_field("load_us", std::to_string(loginLoadTime / logins));
+    }
 }
 
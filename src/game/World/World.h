@@ -90,6 +90,11 @@ enum eConfigUInt32Values
     CONFIG_UINT32_COMPRESSION = 0,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
+    CONFIG_UINT32_GRID_UNLOAD_DELETE_PER_UPDATE,
+    CONFIG_UINT32_GRID_UNLOAD_TILES_PER_UPDATE,
+    CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_INTERVAL,
+    CONFIG_UINT32_SAVE_RESPAWN_TIME_BATCH_SIZE,
+    CONFIG_UINT32_GAME_EVENT_SPAWNS_PER_UPDATE,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
@@ -113,6 +118,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MIN_HONOR_KILLS,
     CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR,
     CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,
+    CONFIG_UINT32_INSTANCE_PREWARM_COUNT,
     CONFIG_UINT32_MAX_SPELL_CASTS_IN_CHAIN,
     CONFIG_UINT32_RABBIT_DAY,
     CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL,
@@ -135,6 +141,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GM_INVISIBLE_AURA,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_MAIL_EXPIRE_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
@@ -171,6 +178,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH,
     CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN,
     CONFIG_UINT32_GROUP_OFFLINE_LEADER_DELAY,
+    CONFIG_UINT32_GROUP_STATS_UPDATE_INTERVAL,
+    CONFIG_UINT32_GROUP_POSITION_UPDATE_INTERVAL,
     CONFIG_UINT32_GUILD_EVENT_LOG_COUNT,
     CONFIG_UINT32_MIRRORTIMER_FATIGUE_MAX,
     CONFIG_UINT32_MIRRORTIMER_BREATH_MAX,
@@ -189,6 +198,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_FOGOFWAR_STATS,
     CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY,
     CONFIG_UINT32_CHANNEL_STATIC_AUTO_TRESHOLD,
+    CONFIG_UINT32_PACKET_BUDGET,
+    CONFIG_UINT32_PACKET_TIME_BUDGET,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -311,6 +322,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_ADDON_CHANNEL,
     CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW,
     CONFIG_BOOL_CORPSE_ALLOW_ALL_ITEMS_SHOW_IN_MASTER_LOOT,
+    CONFIG_BOOL_LOOT_DEFERRED_GENERATION,
     CONFIG_BOOL_DEATH_CORPSE_RECLAIM_DELAY_PVP,
     CONFIG_BOOL_DEATH_CORPSE_RECLAIM_DELAY_PVE,
     CONFIG_BOOL_DEATH_BONES_WORLD,
@@ -540,6 +552,12 @@ class World
         /// Get configuration about force-loaded maps
         bool isForceLoadMap(uint32 id) const { return m_configForceLoadMapIds.find(id) != m_configForceLoadMapIds.end(); }
 
+        /// Get configuration about dungeon maps kept pre-initialized by MapManager
+        std::set<uint32> const& GetPrewarmMapIds() const { return m_configPrewarmMapIds; }
+
+        /// Get the budget cost of handling a client packet (see Network.PacketCost)
+        uint32 GetPacketCost(uint16 opcode) const { return opcode < m_configPacketCosts.size() ? m_configPacketCosts[opcode] : 1; }
+
         /// Are we on a "Player versus Player" server?
         bool IsPvPRealm() const { return (getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_PVP || getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_RPPVP || getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_FFA_PVP); }
         bool IsFFAPvPRealm() const { return getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_FFA_PVP; }
@@ -608,6 +626,8 @@ class World
         Messager<World>& GetMessager() { return m_messager; }
 
         void IncrementOpcodeCounter(uint32 opcodeId); // thread safe due to atomics
+        // times in microseconds: waiting for the login queries, loading the player from their results
+        void RecordPlayerLogin(uint64 queryTime, uint64 loadTime); // thread safe due to atomics
     protected:
         void _UpdateGameTime();
         // callback for UpdateRealmCharacters
@@ -699,6 +719,10 @@ class World
 
         // List of Maps that should be force-loaded on startup
         std::set<uint32> m_configForceLoadMapIds;
+        std::set<uint32> m_configPrewarmMapIds;
+
+        // budget cost of each client opcode, indexed by opcode
+        std::vector<uint32> m_configPacketCosts;
 
         std::vector<std::string> m_spamRecords;
 
@@ -710,6 +734,10 @@ class World
 
         // Opcode logging
         std::vector<std::atomic<uint32>> m_opcodeCounters;
+        // login logging
+        std::atomic<uint32> m_loginCount;
+        std::atomic<uint64> m_loginQueryTime;
+        std::atomic<uint64> m_loginLoadTime;
         // online count logging
         std::array<std::atomic<uint32>, 2> m_onlineTeams;
         std::array<std::atomic<uint32>, MAX_RACES> m_onlineRaces;
@@ -352,6 +352,7 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nReaders = sConfig.GetIntDefault("CharacterDatabaseReaders", 4);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -360,10 +361,10 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + 1 + std::max(nReaders, 0));
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nReaders))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
@@ -24,6 +24,7 @@
 #include "Auth/HMACSHA1.h"
 #include "Auth/base32.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Config/Config.h"
 #include "Log.h"
 #include "RealmList.h"
@@ -31,6 +32,7 @@
 #include "AuthCodes.h"
 #include "SRP6/SRP6.h"
 #include "CommonDefines.h"
+#include "Metric/Metric.h"
 
 #include <openssl/md5.h>
 #include <ctime>
@@ -176,9 +178,50 @@ typedef struct AuthHandler
 
 std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B, 0x21, 0x57, 0xFC, 0x37, 0x3F, 0xB3, 0x69, 0xCD, 0xD2, 0xF1 } };
 
+enum LogonChallengeQueryIndex
+{
+    LOGON_CHALLENGE_QUERY_IP_BANNED,
+    LOGON_CHALLENGE_QUERY_ACCOUNT,
+    LOGON_CHALLENGE_QUERY_ACCOUNT_BANNED,
+    MAX_LOGON_CHALLENGE_QUERY
+};
+
+/// Login database callbacks, run by the thread processing the result queue (see main loop).
+/// They only hand the results back to the network thread of the socket, which owns its state.
+class AuthQueryHandler
+{
+    public:
+        void HandleLogonChallengeCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder, std::shared_ptr<AuthSocket> socket)
+        {
+            socket->GetIoService().post([socket, holder]() { socket->_HandleLogonChallengeResult(holder); });
+        }
+
+        void HandleReconnectChallengeCallback(QueryResult* result, std::shared_ptr<AuthSocket> socket)
+        {
+            socket->GetIoService().post([socket, result]() { socket->_HandleReconnectChallengeResult(result); });
+        }
+
+        void HandleRealmListCallback(QueryResult* result, std::shared_ptr<AuthSocket> socket)
+        {
+            socket->GetIoService().post([socket, result]() { socket->_HandleRealmListResult(result); });
+        }
+} authQueryHandler;
+
+/// realmd.logon.proof measurement: proof handling time as "duration", tagged with the outcome when the handler returns
+class LogonProofMeasurement : public metric::duration<std::chrono::microseconds>
+{
+    public:
+        LogonProofMeasurement(bool const& authenticated) : metric::duration<std::chrono::microseconds>("realmd.logon.proof"), m_authenticated(authenticated) {}
+        ~LogonProofMeasurement() { add_tag("result", m_authenticated ? "authenticated" : "failed"); }
+
+    private:
+        bool const& m_authenticated;
+};
+
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
-    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER), m_timeoutTimer(service)
+    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER),
+      _accountId(0), _failedLogins(0), m_service(service), m_timeoutTimer(service)
 {
     m_timeoutTimer.expires_from_now(boost::posix_time::seconds(30));
     m_timeoutTimer.async_wait([&] (const boost::system::error_code& error)
@@ -320,6 +363,7 @@ bool AuthSocket::_HandleLogonChallenge()
 
     ///- Session is closed unless overriden
     _status = STATUS_CLOSED;
+    _challengeTime = std::chrono::steady_clock::now();
 
     // No big fear of memory outage (size is int16, i.e. < 65536)
     buf.resize(remaining + buf.size() + 1);
@@ -341,8 +385,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -355,6 +397,10 @@ bool AuthSocket::_HandleLogonChallenge()
     // Restore string order as its byte order is reversed
     std::reverse(m_os.begin(), m_os.end());
 
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4 - i - 1];
+
     ///- Normalize account name
     // utf8ToUpperOnlyLatin(_login); -- client already send account in expected form
 
@@ -363,14 +409,40 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
+    ///- Fetch the ip ban, the account and its ban in one go, the answer is sent from _HandleLogonChallengeResult
+    // No SQL injection possible (escaped user name and IP address as passed by the socket)
+    SqlQueryHolder* holder = new SqlQueryHolder;
+    holder->SetSize(MAX_LOGON_CHALLENGE_QUERY);
+    holder->SetPQuery(LOGON_CHALLENGE_QUERY_IP_BANNED, "SELECT expires_at FROM ip_banned "
+                      "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str());
+    holder->SetPQuery(LOGON_CHALLENGE_QUERY_ACCOUNT, "SELECT id,locked,lockedIp,gmlevel,v,s,token,failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
+    holder->SetPQuery(LOGON_CHALLENGE_QUERY_ACCOUNT_BANNED, "SELECT banned_at,expires_at FROM account_banned WHERE "
+                      "account_id = (SELECT id FROM account WHERE username = '%s') AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)", _safelogin.c_str());
+
+    if (!LoginDatabase.DelayQueryHolder(&authQueryHandler, &AuthQueryHandler::HandleLogonChallengeCallback, holder, shared<AuthSocket>()))
+    {
+        delete holder;
+        return false;
+    }
+
+    return true;
+}
+
+void AuthSocket::_HandleLogonChallengeResult(SqlQueryHolder* holder)
+{
+    std::unique_ptr<SqlQueryHolder> holderGuard(holder);
+    std::unique_ptr<QueryResult> ip_banned_result(holder->GetResult(LOGON_CHALLENGE_QUERY_IP_BANNED));
+    std::unique_ptr<QueryResult> result(holder->GetResult(LOGON_CHALLENGE_QUERY_ACCOUNT));
+    std::unique_ptr<QueryResult> banresult(holder->GetResult(LOGON_CHALLENGE_QUERY_ACCOUNT_BANNED));
+
+    if (IsClosed())
+        return;
+
+    ByteBuffer pkt;
     pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
     pkt << (uint8) 0x00;
 
     ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
-    std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-            "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str()));
-
     if (ip_banned_result)
     {
         pkt << (uint8)WOW_FAIL_FAIL_NOACCESS;
@@ -379,8 +451,6 @@ bool AuthSocket::_HandleLogonChallenge()
     else
     {
         ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
-        QueryResult* result = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", _safelogin.c_str());
         if (result)
         {
             Field* fields = result->Fetch();
@@ -417,8 +487,6 @@ bool AuthSocket::_HandleLogonChallenge()
             if (!locked && !broken)
             {
                 ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                                         "account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)", fields[1].GetUInt32());
                 if (banresult)
                 {
                     if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
@@ -431,8 +499,6 @@ bool AuthSocket::_HandleLogonChallenge()
                         pkt << (uint8) WOW_FAIL_SUSPENDED;
                         BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
                     }
-
-                    delete banresult;
                 }
                 else
                 {
@@ -484,24 +550,26 @@ bool AuthSocket::_HandleLogonChallenge()
                     uint8 secLevel = fields[3].GetUInt8();
                     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4 - i - 1];
+                    // kept for the proof, which then needs no query of its own
+                    _accountId = fields[0].GetUInt32();
+                    _failedLogins = fields[7].GetUInt32();
 
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
+                    BASIC_LOG("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
                     ///- All good, await client's proof
                     _status = STATUS_LOGON_PROOF;
                 }
             }
-            delete result;
         }
         else                                                // no account
             pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
     }
 
     Write((const char*)pkt.contents(), pkt.size());
-    return true;
+
+    // time from the challenge arrival to its answer, nearly all of it spent in the login database queue
+    metric::measurement meas("realmd.logon.challenge", { { "result", _status == STATUS_LOGON_PROOF ? "accepted" : "rejected" } });
+    meas.add_field("duration", int64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _challengeTime).count()));
 }
 
 /// Logon Proof command handler
@@ -516,6 +584,10 @@ bool AuthSocket::_HandleLogonProof()
     ///- Session is closed unless overriden
     _status = STATUS_CLOSED;
 
+    bool authenticated = false;
+    LogonProofMeasurement meas(authenticated);
+    meas.add_field("challenge_to_proof", int64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _challengeTime).count()));
+
     /// <ul><li> If the client has no valid version
     if (!FindBuildInfo(_build))
     {
@@ -589,8 +661,7 @@ bool AuthSocket::_HandleLogonProof()
         // No SQL injection (escaped user name) and IP address as received by socket
         const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
         LoginDatabase.PExecute("UPDATE account SET sessionkey = '%s', locale = '%u', failed_logins = 0 WHERE username = '%s'", K_hex, GetLocaleByName(_localizationName), _safelogin.c_str());
-        if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()))
-            LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s',NOW(),'%u')", loginfail->Fetch()[0].GetUInt32(), m_address.c_str(), LOGIN_TYPE_REALMD);
+        LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s',NOW(),'%u')", _accountId, m_address.c_str(), LOGIN_TYPE_REALMD);
         OPENSSL_free((void*)K_hex);
 
         ///- Finish SRP6 and send the final result to the client
@@ -601,6 +672,7 @@ bool AuthSocket::_HandleLogonProof()
 
         ///- Set _status to authed!
         _status = STATUS_AUTHED;
+        authenticated = true;
     }
     else
     {
@@ -622,38 +694,32 @@ bool AuthSocket::_HandleLogonProof()
         if (MaxWrongPassCount > 0)
         {
             // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+            // The count read at challenge time is used instead of reading it back, the update above is only queued
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
+            uint32 failed_logins = ++_failedLogins;
 
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
+            if (failed_logins >= MaxWrongPassCount)
             {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+                uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+                bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
 
-                if (failed_logins >= MaxWrongPassCount)
+                if (WrongPassBanType)
                 {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
-                                               "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
+                    LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
+                                           "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                           _accountId, WrongPassBanTime);
+                    BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                              _login.c_str(), WrongPassBanTime, failed_logins);
+                }
+                else
+                {
+                    std::string current_ip = m_address;
+                    LoginDatabase.escape_string(current_ip);
+                    LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                           current_ip.c_str(), WrongPassBanTime);
+                    BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                              current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
                 }
-                delete loginfail;
             }
         }
     }
@@ -684,6 +750,7 @@ bool AuthSocket::_HandleReconnectChallenge()
 
     ///- Session is closed unless overriden
     _status = STATUS_CLOSED;
+    _challengeTime = std::chrono::steady_clock::now();
 
     // No big fear of memory outage (size is int16, i.e. < 65536)
     buf.resize(remaining + buf.size() + 1);
@@ -703,19 +770,29 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+    ///- The answer is sent from _HandleReconnectChallengeResult
+    return LoginDatabase.AsyncPQuery(&authQueryHandler, &AuthQueryHandler::HandleReconnectChallengeCallback, shared<AuthSocket>(),
+                                     "SELECT sessionkey, id FROM account WHERE username = '%s'", _safelogin.c_str());
+}
+
+void AuthSocket::_HandleReconnectChallengeResult(QueryResult* result)
+{
+    std::unique_ptr<QueryResult> resultGuard(result);
+
+    if (IsClosed())
+        return;
 
     // Stop if the account is not found
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
         Close();
-        return false;
+        return;
     }
 
     Field* fields = result->Fetch();
     srp.SetStrongSessionKey(fields[0].GetString());
-    delete result;
+    _accountId = fields[1].GetUInt32();
 
     ///- All good, await client's proof
     _status = STATUS_RECON_PROOF;
@@ -728,7 +805,6 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt.append(_reconnectProof.AsByteArray(16), 16);        // 16 bytes random
     pkt.append(VersionChallenge.data(), VersionChallenge.size());
     Write((const char*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Reconnect Proof command handler
@@ -792,163 +868,56 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
-    // No SQL injection (escaped user name)
-
-    QueryResult* result = LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str());
-    if (!result)
-    {
-        sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
-        Close();
-        return false;
-    }
-
-    uint32 id = (*result)[0].GetUInt32();
-    delete result;
-
     ///- Update realm list if need
     sRealmList.UpdateIfNeed();
 
-    ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
+    ///- Answer from the cached realm list when the character counts of the account are known
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
-
-    ByteBuffer hdr;
-    hdr << (uint8) CMD_REALM_LIST;
-    hdr << (uint16)pkt.size();
-    hdr.append(pkt);
+    if (sRealmList.BuildRealmListPacket(pkt, _build, _accountSecurityLevel, _accountId))
+    {
+        SendRealmList(pkt);
+        return true;
+    }
 
-    Write((const char*)hdr.contents(), hdr.size());
-    return true;
+    ///- Else load them, the answer is sent from _HandleRealmListResult
+    return LoginDatabase.AsyncPQuery(&authQueryHandler, &AuthQueryHandler::HandleRealmListCallback, shared<AuthSocket>(),
+                                     "SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", _accountId);
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
+void AuthSocket::_HandleRealmListResult(QueryResult* result)
 {
-    switch (_build)
-    {
-        case 5875:                                          // 1.12.1
-        case 6005:                                          // 1.12.2
-        case 6141:                                          // 1.12.3
-        {
-            pkt << uint32(0);                               // unused value
-            pkt << uint8(sRealmList.size());
-
-            for (const auto& i : sRealmList)
-            {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                RealmFlags realmflags = i.second.realmflags;
-
-                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
-                std::string name = i.first;
-                if (realmflags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    char buf[20];
-                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
-                    name += buf;
-                }
+    std::unique_ptr<QueryResult> resultGuard(result);
 
-                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
-                if (!ok_build || (i.second.allowedSecurityLevel > _accountSecurityLevel))
-                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
-
-                pkt << uint32(i.second.icon);              // realm type
-                pkt << uint8(realmflags);                   // realmflags
-                pkt << name;                                // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(i.second.timezone);           // realm category
-                pkt << uint8(0x00);                         // unk, may be realm number/id?
-            }
-
-            pkt << uint16(0x0002);                          // unused value (why 2?)
-            break;
-        }
+    if (IsClosed())
+        return;
 
-        case 8606:                                          // 2.4.3
-        case 10505:                                         // 3.2.2a
-        case 11159:                                         // 3.3.0a
-        case 11403:                                         // 3.3.2
-        case 11723:                                         // 3.3.3a
-        case 12340:                                         // 3.3.5a
-        default:                                            // and later
+    RealmCharacterCounts counts;
+    if (result)
+    {
+        do
         {
-            pkt << uint32(0);                               // unused value
-            pkt << uint16(sRealmList.size());
-
-            for (const auto& i : sRealmList)
-            {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                uint8 lock = (i.second.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
-
-                RealmFlags realmFlags = i.second.realmflags;
-
-                // Show offline state for unsupported client builds
-                if (!ok_build)
-                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
+            Field* fields = result->Fetch();
+            counts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        }
+        while (result->NextRow());
+    }
 
-                //if (!buildInfo) // always false since updated 10 lines above if null. ToDo: fix
-                //    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+    sRealmList.SetCharacterCounts(_accountId, counts);
 
-                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
-                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
-                pkt << uint8(realmFlags);                   // see enum RealmFlags
-                pkt << i.first;                            // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(i.second.timezone);           // realm category (Cfg_Categories.dbc)
-                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+    ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
+    ByteBuffer pkt;
+    sRealmList.BuildRealmListPacket(pkt, _build, _accountSecurityLevel, counts);
+    SendRealmList(pkt);
+}
 
-                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    pkt << uint8(buildInfo->major_version);
-                    pkt << uint8(buildInfo->minor_version);
-                    pkt << uint8(buildInfo->bugfix_version);
-                    pkt << uint16(_build);
-                }
-            }
+void AuthSocket::SendRealmList(ByteBuffer const& pkt)
+{
+    ByteBuffer hdr;
+    hdr << (uint8) CMD_REALM_LIST;
+    hdr << (uint16)pkt.size();
+    hdr.append(pkt);
 
-            pkt << uint16(0x0010);                          // unused value (why 10?)
-            break;
-        }
-    }
+    Write((const char*)hdr.contents(), hdr.size());
 }
 
 /// Resume patch transfer
@@ -33,10 +33,14 @@
 
 #include <boost/asio.hpp>
 
+#include <chrono>
 #include <functional>
 
 #define HMAC_RES_SIZE 20
 
+class QueryResult;
+class SqlQueryHolder;
+
 class AuthSocket : public MaNGOS::Socket
 {
     public:
@@ -45,7 +49,7 @@ class AuthSocket : public MaNGOS::Socket
         AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler);
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid);
+        void SendRealmList(ByteBuffer const& pkt);
         int32 generateToken(char const* b32key);
 
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
@@ -60,6 +64,13 @@ class AuthSocket : public MaNGOS::Socket
         bool _HandleXferCancel();
         bool _HandleXferAccept();
 
+        // continuations of the handlers waiting for the login database, run on the socket network thread
+        void _HandleLogonChallengeResult(SqlQueryHolder* holder);
+        void _HandleReconnectChallengeResult(QueryResult* result);
+        void _HandleRealmListResult(QueryResult* result);
+
+        boost::asio::io_service& GetIoService() { return m_service; }
+
     private:
         enum eStatus
         {
@@ -86,6 +97,13 @@ class AuthSocket : public MaNGOS::Socket
         std::string _localizationName;
         uint16 _build;
         AccountTypes _accountSecurityLevel;
+        uint32 _accountId;
+        uint32 _failedLogins;
+
+        // arrival of the logon challenge, start of the challenge-to-proof latency
+        std::chrono::steady_clock::time_point _challengeTime;
+
+        boost::asio::io_service& m_service;
 
         boost::asio::deadline_timer m_timeoutTimer;
 
@@ -222,7 +222,7 @@ int main(int argc, char* argv[])
     }
 
     ///- Get the list of realms for the server
-    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20));
+    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20), sConfig.GetIntDefault("RealmCharactersCacheTime", 10));
     if (sRealmList.size() == 0)
     {
         sLog.outError("No valid realms specified.");
@@ -289,8 +289,11 @@ int main(int argc, char* argv[])
     // server has started up successfully => enable async DB requests
     LoginDatabase.AllowAsyncTransactions();
 
+    // main loop period in milliseconds, it also bounds the delay before the auth sockets get their async query results
+    uint32 const loopPeriod = 10;
+
     // maximum counter for next ping
-    auto const numLoops = sConfig.GetIntDefault("MaxPingTime", 30) * MINUTE * 10;
+    auto const numLoops = sConfig.GetIntDefault("MaxPingTime", 30) * MINUTE * (IN_MILLISECONDS / loopPeriod);
     uint32 loopCounter = 0;
 
 #ifndef _WIN32
@@ -305,7 +308,11 @@ int main(int argc, char* argv[])
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // hand the login database results back to the waiting auth sockets
+        LoginDatabase.ProcessResultQueue();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(loopPeriod));
 #ifdef _WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
         while (m_ServiceStatus == 2) Sleep(1000);
@@ -75,7 +75,8 @@ RealmBuildInfo const* FindBuildInfo(uint16 _build)
     return nullptr;
 }
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
+RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr)),
+    m_characterCountCacheTime(0), m_NextCharacterCountPurgeTime(time(nullptr))
 {
 }
 
@@ -86,9 +87,10 @@ RealmList& sRealmList
 }
 
 /// Load the realm list from the database
-void RealmList::Initialize(uint32 updateInterval)
+void RealmList::Initialize(uint32 updateInterval, uint32 characterCountCacheTime)
 {
     m_UpdateInterval = updateInterval;
+    m_characterCountCacheTime = characterCountCacheTime;
 
     ///- Get the content of the realmlist table in the database
     UpdateRealms(true);
@@ -135,19 +137,202 @@ void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::strin
 
 void RealmList::UpdateIfNeed()
 {
+    time_t now = time(nullptr);
+
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+
+    // forget character counts not requested again in time
+    if (m_NextCharacterCountPurgeTime <= now)
+    {
+        m_NextCharacterCountPurgeTime = now + m_characterCountCacheTime;
+
+        for (CharacterCountMap::iterator itr = m_characterCounts.begin(); itr != m_characterCounts.end();)
+        {
+            if (itr->second.expireTime <= now)
+                itr = m_characterCounts.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
     // maybe disabled or updated recently
-    if (!m_UpdateInterval || m_NextUpdateTime > time(nullptr))
+    if (!m_UpdateInterval || m_NextUpdateTime > now)
         return;
 
-    m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
+    m_NextUpdateTime = now + m_UpdateInterval;
 
     // Clears Realm list
     m_realms.clear();
+    m_realmListPackets.clear();
 
     // Get the content of the realmlist table in the database
     UpdateRealms(false);
 }
 
+void RealmList::SetCharacterCounts(uint32 accountId, RealmCharacterCounts const& counts)
+{
+    if (!m_characterCountCacheTime)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+
+    CachedCharacterCounts& cached = m_characterCounts[accountId];
+    cached.expireTime = time(nullptr) + m_characterCountCacheTime;
+    cached.counts = counts;
+}
+
+bool RealmList::BuildRealmListPacket(ByteBuffer& pkt, uint16 build, AccountTypes security, uint32 accountId)
+{
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+
+    CharacterCountMap::const_iterator cached = m_characterCounts.find(accountId);
+    if (cached == m_characterCounts.end() || cached->second.expireTime <= time(nullptr))
+        return false;
+
+    AppendRealmListPacket(pkt, build, security, cached->second.counts);
+    return true;
+}
+
+void RealmList::BuildRealmListPacket(ByteBuffer& pkt, uint16 build, AccountTypes security, RealmCharacterCounts const& counts)
+{
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+
+    AppendRealmListPacket(pkt, build, security, counts);
+}
+
+/// Copy the serialized realm list and patch in the character counts of the account (m_cacheLock must be held)
+void RealmList::AppendRealmListPacket(ByteBuffer& pkt, uint16 build, AccountTypes security, RealmCharacterCounts const& counts)
+{
+    RealmListPacket const& packet = GetRealmListPacket(build, security);
+
+    size_t const base = pkt.wpos();
+    pkt.append(packet.data);
+
+    for (auto const& pos : packet.characterCountPos)
+    {
+        RealmCharacterCounts::const_iterator count = counts.find(pos.first);
+        if (count != counts.end())
+            pkt.put<uint8>(base + pos.second, count->second);
+    }
+}
+
+/// Serialized realm list for this build and security level, built on first use after each realm update (m_cacheLock must be held)
+RealmListPacket const& RealmList::GetRealmListPacket(uint16 build, AccountTypes security)
+{
+    RealmListPacket& packet = m_realmListPackets[(uint32(build) << 8) | uint32(security)];
+    if (packet.data.empty())
+        SerializeRealms(packet, build, security);
+
+    return packet;
+}
+
+void RealmList::SerializeRealms(RealmListPacket& packet, uint16 build, AccountTypes security) const
+{
+    ByteBuffer& pkt = packet.data;
+
+    switch (build)
+    {
+        case 5875:                                          // 1.12.1
+        case 6005:                                          // 1.12.2
+        case 6141:                                          // 1.12.3
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint8(m_realms.size());
+
+            for (const auto& i : m_realms)
+            {
+                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                RealmFlags realmflags = i.second.realmflags;
+
+                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
+                std::string name = i.first;
+                if (realmflags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    char buf[20];
+                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
+                    name += buf;
+                }
+
+                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
+                if (!ok_build || (i.second.allowedSecurityLevel > security))
+                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
+
+                pkt << uint32(i.second.icon);              // realm type
+                pkt << uint8(realmflags);                   // realmflags
+                pkt << name;                                // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                packet.characterCountPos.emplace_back(i.second.m_ID, pkt.wpos());
+                pkt << uint8(0);                            // AmountOfCharacters, patched per account
+                pkt << uint8(i.second.timezone);           // realm category
+                pkt << uint8(0x00);                         // unk, may be realm number/id?
+            }
+
+            pkt << uint16(0x0002);                          // unused value (why 2?)
+            break;
+        }
+
+        case 8606:                                          // 2.4.3
+        case 10505:                                         // 3.2.2a
+        case 11159:                                         // 3.3.0a
+        case 11403:                                         // 3.3.2
+        case 11723:                                         // 3.3.3a
+        case 12340:                                         // 3.3.5a
+        default:                                            // and later
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint16(m_realms.size());
+
+            for (const auto& i : m_realms)
+            {
+                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                uint8 lock = (i.second.allowedSecurityLevel > security) ? 1 : 0;
+
+                RealmFlags realmFlags = i.second.realmflags;
+
+                // Show offline state for unsupported client builds
+                if (!ok_build)
+                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
+
+                //if (!buildInfo) // always false since updated 10 lines above if null. ToDo: fix
+                //    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+
+                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
+                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
+                pkt << uint8(realmFlags);                   // see enum RealmFlags
+                pkt << i.first;                            // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                packet.characterCountPos.emplace_back(i.second.m_ID, pkt.wpos());
+                pkt << uint8(0);                            // AmountOfCharacters, patched per account
+                pkt << uint8(i.second.timezone);           // realm category (Cfg_Categories.dbc)
+                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+
+                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    pkt << uint8(buildInfo->major_version);
+                    pkt << uint8(buildInfo->minor_version);
+                    pkt << uint8(buildInfo->bugfix_version);
+                    pkt << uint16(build);
+                }
+            }
+
+            pkt << uint16(0x0010);                          // unused value (why 10?)
+            break;
+        }
+    }
+}
+
 void RealmList::UpdateRealms(bool init)
 {
     DETAIL_LOG("Updating Realm List...");
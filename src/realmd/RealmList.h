@@ -24,7 +24,11 @@
 #define _REALMLIST_H
 
 #include "Common.h"
+#include "ByteBuffer.h"
+
 #include <array>
+#include <mutex>
+#include <unordered_map>
 
 struct RealmBuildInfo
 {
@@ -55,6 +59,16 @@ struct Realm
     RealmBuildInfo realmBuildInfo;                          // build info for show version in list
 };
 
+typedef std::map<uint32 /*realmId*/, uint8 /*numchars*/> RealmCharacterCounts;
+
+/// Realm list body serialized for one client build and account security level,
+/// the character counts are patched in per account at the recorded positions
+struct RealmListPacket
+{
+    ByteBuffer data;
+    std::vector<std::pair<uint32 /*realmId*/, size_t /*pos*/> > characterCountPos;
+};
+
 /// Storage object for the list of realms on the server
 class RealmList
 {
@@ -66,20 +80,43 @@ class RealmList
         RealmList();
         ~RealmList() {}
 
-        void Initialize(uint32 updateInterval);
+        void Initialize(uint32 updateInterval, uint32 characterCountCacheTime);
 
         void UpdateIfNeed();
 
+        /// Build the realm list body for this client and account, false if the character counts of the account are not cached
+        bool BuildRealmListPacket(ByteBuffer& pkt, uint16 build, AccountTypes security, uint32 accountId);
+        void BuildRealmListPacket(ByteBuffer& pkt, uint16 build, AccountTypes security, RealmCharacterCounts const& counts);
+        void SetCharacterCounts(uint32 accountId, RealmCharacterCounts const& counts);
+
         RealmMap::const_iterator begin() const { return m_realms.begin(); }
         RealmMap::const_iterator end() const { return m_realms.end(); }
         uint32 size() const { return m_realms.size(); }
     private:
         void UpdateRealms(bool init);
         void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        void AppendRealmListPacket(ByteBuffer& pkt, uint16 build, AccountTypes security, RealmCharacterCounts const& counts);
+        RealmListPacket const& GetRealmListPacket(uint16 build, AccountTypes security);
+        void SerializeRealms(RealmListPacket& packet, uint16 build, AccountTypes security) const;
+
+        struct CachedCharacterCounts
+        {
+            time_t expireTime;
+            RealmCharacterCounts counts;
+        };
+
+        typedef std::unordered_map<uint32 /*build << 8 | security*/, RealmListPacket> RealmListPacketMap;
+        typedef std::unordered_map<uint32 /*accountId*/, CachedCharacterCounts> CharacterCountMap;
     private:
         RealmMap m_realms;                                  ///< Internal map of realms
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
+
+        std::mutex m_cacheLock;                             ///< Guards the two caches below, realm list requests come from the network threads
+        RealmListPacketMap m_realmListPackets;              ///< Serialized realm lists, cleared at each realm update
+        CharacterCountMap m_characterCounts;                ///< Per account character counts, kept for m_characterCountCacheTime seconds
+        uint32   m_characterCountCacheTime;
+        time_t   m_NextCharacterCountPurgeTime;
 };
 
 #define sRealmList RealmList::Instance()
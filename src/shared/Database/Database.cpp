@@ -97,7 +97,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nReaders /*= 0*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -139,6 +139,20 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     if (!m_pAsyncConn->Initialize(infoString))
         return false;
 
+    // create reader connections for parallel query holder execution
+    nReaders = std::min(std::max(nReaders, 0), MAX_CONNECTION_POOL_SIZE);
+    for (int i = 0; i < nReaders; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pReaderConns.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -159,6 +173,11 @@ void Database::StopServer()
         delete m_pQueryConnection;
 
     m_pQueryConnections.clear();
+
+    for (auto& m_pReaderConn : m_pReaderConns)
+        delete m_pReaderConn;
+
+    m_pReaderConns.clear();
 }
 
 SqlDelayThread* Database::CreateDelayThread()
@@ -174,6 +193,13 @@ void Database::InitDelayThread()
     // New delay thread for delay execute
     m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
     m_delayThread = new MaNGOS::Thread(m_threadBody);
+
+    for (auto& m_pReaderConn : m_pReaderConns)
+    {
+        SqlDelayThread* readerBody = new SqlDelayThread(this, m_pReaderConn, false);
+        m_readerBodies.push_back(readerBody);
+        m_readerThreads.push_back(new MaNGOS::Thread(readerBody));
+    }
 }
 
 void Database::HaltDelayThread()
@@ -185,6 +211,17 @@ void Database::HaltDelayThread()
     delete m_delayThread;                                   // This also deletes m_threadBody
     m_delayThread = nullptr;
     m_threadBody = nullptr;
+
+    // readers go last, the delay thread flush above may still hand query holders to them
+    for (size_t i = 0; i < m_readerThreads.size(); ++i)
+    {
+        m_readerBodies[i]->Stop();
+        m_readerThreads[i]->wait();
+        delete m_readerThreads[i];                          // This also deletes m_readerBodies[i]
+    }
+
+    m_readerThreads.clear();
+    m_readerBodies.clear();
 }
 
 void Database::ThreadStart()
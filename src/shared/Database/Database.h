@@ -104,10 +104,11 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        // nReaders connections with own threads execute query holders in parallel, 0 keeps them on the async connection
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nReaders = 0);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -186,6 +187,8 @@ class Database
         bool BeginTransaction();
         bool CommitTransaction();
         bool RollbackTransaction();
+        // true if the calling thread has an open transaction, callers that may run inside a batch join it instead of nesting
+        bool IsInTransaction() const { return m_currentTransaction.get() != nullptr; }
         // for sync transaction execution
         bool CommitTransactionDirect();
 
@@ -267,6 +270,11 @@ class Database
         SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
         MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
 
+        // read only connections for query holders, each one served by its own thread
+        SqlConnectionContainer m_pReaderConns;
+        SqlReaderThreads m_readerBodies;                    ///< Reader sql executers (owned by m_readerThreads)
+        std::vector<MaNGOS::Thread*> m_readerThreads;
+
         bool m_bAllowAsyncTransactions;                     ///< flag which specifies if async transactions are enabled
 
         // PREPARED STATEMENT REGISTRY
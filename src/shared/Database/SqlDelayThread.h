@@ -37,13 +37,14 @@ class SqlDelayThread : public MaNGOS::Runnable
         std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
+        bool m_pingEngine;                                      ///< Ping all engine connections, otherwise only own one
         volatile bool m_running;
 
         // process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingEngine = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
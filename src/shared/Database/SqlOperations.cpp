@@ -117,14 +117,14 @@ void SqlResultQueue::Add(MaNGOS::IQueryCallback* callback)
     m_queue.push(std::unique_ptr<MaNGOS::IQueryCallback>(callback));
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue, SqlReaderThreads const* readers)
 {
     if (!callback || !thread || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
+    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue, readers);
     thread->Delay(holderEx);
     return true;
 }
@@ -220,9 +220,30 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     if (!m_holder || !m_callback || !m_queue)
         return false;
 
-    LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
+
+    /// reaching this point on the delay thread means every write queued before the holder is done,
+    /// so the queries can be spread over the reader connections without reading stale data
+    if (m_readers && !m_readers->empty() && queries.size() > 1)
+    {
+        size_t partCount = std::min(m_readers->size(), queries.size());
+        std::shared_ptr<SqlQueryHolderPart::Batch> batch(new SqlQueryHolderPart::Batch(m_holder, m_callback, m_queue, partCount));
+
+        std::vector<SqlQueryHolderPart*> parts(partCount);
+        for (size_t i = 0; i < partCount; ++i)
+            parts[i] = new SqlQueryHolderPart(batch);
+
+        for (size_t i = 0; i < queries.size(); ++i)
+            parts[i % partCount]->AddIndex(i);
+
+        for (size_t i = 0; i < partCount; ++i)
+            (*m_readers)[i]->Delay(parts[i]);
+
+        return true;
+    }
+
+    LOCK_DB_CONN(conn);
     for (size_t i = 0; i < queries.size(); ++i)
     {
         /// execute all queries in the holder and pass the results
@@ -235,3 +256,23 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
 
     return true;
 }
+
+bool SqlQueryHolderPart::Execute(SqlConnection* conn)
+{
+    {
+        LOCK_DB_CONN(conn);
+        /// every part writes only its own result slots
+        std::vector<SqlQueryHolder::SqlResultPair>& queries = m_batch->holder->m_queries;
+        for (size_t index : m_indexes)
+        {
+            char const* sql = queries[index].first;
+            if (sql) m_batch->holder->SetResult(index, conn->Query(sql));
+        }
+    }
+
+    /// the last part syncs with the caller thread
+    if (m_batch->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_batch->queue->Add(m_batch->callback);
+
+    return true;
+}
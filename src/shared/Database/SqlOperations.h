@@ -26,6 +26,7 @@
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 /// ---- BASE ---
 
@@ -87,6 +88,9 @@ class SqlQuery;                                             /// contains a singl
 class QueryResult;                                          /// the result of one
 class SqlQueryHolder;                                       /// groups several async quries
 class SqlQueryHolderEx;                                     /// points to a holder, added to the delay thread
+class SqlQueryHolderPart;                                   /// part of a holder, added to a reader thread
+
+typedef std::vector<SqlDelayThread*> SqlReaderThreads;
 
 class SqlResultQueue
 {
@@ -119,6 +123,7 @@ class SqlQuery : public SqlOperation
 class SqlQueryHolder
 {
         friend class SqlQueryHolderEx;
+        friend class SqlQueryHolderPart;
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
@@ -130,7 +135,7 @@ class SqlQueryHolder
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult* result);
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue, SqlReaderThreads const* readers = nullptr);
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -139,9 +144,35 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        SqlReaderThreads const* m_readers;
+    public:
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, SqlReaderThreads const* readers)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_readers(readers) {}
+        bool Execute(SqlConnection* conn) override;
+};
+
+/// executes a subset of the holder queries, the part finishing last passes the callback to the result queue
+class SqlQueryHolderPart : public SqlOperation
+{
     public:
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        struct Batch
+        {
+            Batch(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, size_t parts)
+                : holder(holder), callback(callback), queue(queue), pending(parts) {}
+
+            SqlQueryHolder* holder;
+            MaNGOS::IQueryCallback* callback;
+            SqlResultQueue* queue;
+            std::atomic<size_t> pending;
+        };
+
+        SqlQueryHolderPart(std::shared_ptr<Batch> batch) : m_batch(std::move(batch)) {}
+
+        void AddIndex(size_t index) { m_indexes.push_back(index); }
         bool Execute(SqlConnection* conn) override;
+
+    private:
+        std::shared_ptr<Batch> m_batch;
+        std::vector<size_t> m_indexes;
 };
 #endif                                                      //__SQLOPERATIONS_H
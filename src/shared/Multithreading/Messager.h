@@ -20,6 +20,7 @@
 #define MANGOS_MESSAGER_H
 
 #include <vector>
+#include <algorithm>
 #include <mutex>
 #include <functional>
 
@@ -40,6 +41,16 @@ class Messager
 
             m_messageVector.clear();
         }
+        // Execute at most maxMessages messages in arrival order, the others are kept for the next call
+        void Execute(T* object, size_t maxMessages)
+        {
+            std::lock_guard<std::mutex> guard(m_messageMutex);
+            size_t count = std::min(maxMessages, m_messageVector.size());
+            for (size_t i = 0; i < count; ++i)
+                m_messageVector[i](object);
+
+            m_messageVector.erase(m_messageVector.begin(), m_messageVector.begin() + count);
+        }
     private:
         std::vector<std::function<void(T*)>> m_messageVector;
         std::mutex m_messageMutex;  
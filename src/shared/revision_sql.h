@@ -2,5 +2,5 @@
 #define __REVISION_SQL_H__
  #define REVISION_DB_REALMD "required_z2766_01_realmd_account_logons"
  #define REVISION_DB_CHARACTERS "required_z2765_01_characters_item_instance_data_drop"
- #define REVISION_DB_MANGOS "required_z2767_01_mangos_power_regen"
+ #define REVISION_DB_MANGOS "required_z2768_01_mangos_command_server_opcodes"
 #endif // __REVISION_SQL_H__